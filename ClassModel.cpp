@@ -21,6 +21,22 @@ classModel::classModel(srcml_archive* archive, srcml_unit* unit, const std::stri
     findClassName(archive, unit);  
 }
 
+// Copies a class (only used by clone())
+// Methods can only be moved, so they are cloned one by one
+//
+classModel::classModel(const classModel& other) :
+    name(other.name), parentClassName(other.parentClassName), structureType(other.structureType),
+    unitLanguage(other.unitLanguage), stereotype(other.stereotype), methodSignatures(other.methodSignatures),
+    inheritedMethodSignatures(other.inheritedMethodSignatures), attributes(other.attributes),
+    nonPrivateAttributes(other.nonPrivateAttributes), inheritedAttributes(other.inheritedAttributes),
+    nonPrivateInheritedAttributes(other.nonPrivateInheritedAttributes), xpath(other.xpath),
+    inherited(other.inherited), visited(other.visited), constructorDestructorCount(other.constructorDestructorCount),
+    externalMethodStereotypes(other.externalMethodStereotypes) {
+    methods.reserve(other.methods.size());
+    for (const auto& m : other.methods)
+        methods.push_back(m.clone());
+}
+
 void classModel::findClassData(srcml_archive* archive, srcml_unit* unit, const std::string& classXpath, int unitNumber) {
     xpath[unitNumber].push_back(classXpath);
     if (unitLanguage == "C++") findStructureType(archive, unit); // Needed for findParentClassName()
@@ -34,8 +50,8 @@ void classModel::findClassData(srcml_archive* archive, srcml_unit* unit, const s
     // The "this" keyword by itself is assumed to be an "accessor" to the state of the class
     // It is also not a non-primitive
     variable v;
-    v.setName("this");
-    attributes.insert({v.getName(), v});
+    v.setName(SYMBOLS.intern("this"));
+    attributes.insert({v.getNameSymbol(), v});
     
     std::vector<variable> nonPrivateAttributeOrdered; 
     int numOfCurrentNonPrivateAttributes = nonPrivateAttributeOrdered.size();
@@ -195,20 +211,19 @@ void classModel::findAttributeName(srcml_archive* archive, srcml_unit* unit, std
         char* unparsed = nullptr;
         std::size_t size = 0;
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size);     
-        std::string attributeName = unparsed;
+        std::string_view attributeName = unparsed;
 
         variable v;
 
-        // Chop off [] for arrays  
+        // Chop off [] for arrays
         if (unitLanguage == "C++") {
             std::size_t start_position = attributeName.find("[");
-            if (start_position != std::string::npos){
-                attributeName = attributeName.substr(0, start_position);
-                Rtrim(attributeName);
-            }
+            if (start_position != std::string_view::npos)
+                attributeName = Rtrim(attributeName.substr(0, start_position));
         }
 
-        v.setName(attributeName);
+        // Local symbol while the class index of a unit is built in streaming mode (only non-private attributes are kept)
+        v.setName(SYMBOLS.internLocal(attributeName));
 
         attributeOrdered.push_back(v); 
         free(unparsed);
@@ -246,8 +261,8 @@ void classModel::findAttributeType(srcml_archive* archive, srcml_unit* unit, std
             prev = type;
         }
 
-        attributeOrdered[numOfCurrentAttributes + i].setType(type);  
-        attributes.insert({attributeOrdered[numOfCurrentAttributes + i].getName(), attributeOrdered[numOfCurrentAttributes + i]});
+        attributeOrdered[numOfCurrentAttributes + i].setType(SYMBOLS.internLocal(type));  
+        attributes.insert({attributeOrdered[numOfCurrentAttributes + i].getNameSymbol(), attributeOrdered[numOfCurrentAttributes + i]});
         bool nonPrimitiveAttributeExternal = false;
 
         isNonPrimitiveType(type, attributeOrdered[numOfCurrentAttributes + i], unitLanguage, name[3]);
@@ -280,19 +295,17 @@ void classModel::findNonPrivateAttributeName(srcml_archive* archive, srcml_unit*
         char* unparsed = nullptr;
         std::size_t size = 0;
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size); 
-        std::string attributeName = unparsed;
+        std::string_view attributeName = unparsed;
 
         variable v;
-        // Chop off [] for arrays  
+        // Chop off [] for arrays
         if (unitLanguage == "C++") {
             std::size_t start_position = attributeName.find("[");
-            if (start_position != std::string::npos){
-                attributeName = attributeName.substr(0, start_position);
-                Rtrim(attributeName);
-            }
+            if (start_position != std::string_view::npos)
+                attributeName = Rtrim(attributeName.substr(0, start_position));
         }
         
-        v.setName(attributeName);
+        v.setName(SYMBOLS.intern(attributeName));
 
         nonPrivateAttributeOrdered.push_back(v); 
         free(unparsed);
@@ -327,9 +340,9 @@ void classModel::findNonPrivateAttributeType(srcml_archive* archive, srcml_unit*
             prev = type;
         }
 
-        nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i].setType(type);
-        nonPrivateAndInheritedAttributes.insert({nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i].getName(), 
-                                                nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i]});
+        nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i].setType(SYMBOLS.intern(type));
+        writable(nonPrivateAttributes).insert({nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i].getNameSymbol(), 
+                                               nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i]});
 
         bool nonPrimitiveAttributeExternal = false;
         isNonPrimitiveType(type, nonPrivateAttributeOrdered[numOfNonPrivateCurrentAttributes + i], unitLanguage, name[3]);
@@ -373,10 +386,7 @@ void classModel::findMethod(srcml_archive* archive, srcml_unit* unit, const std:
         srcml_unit* methodUnit = srcml_archive_read_unit(methodArchive);
 
         std::string methodXpath = "(" + classXpath + XPATH_TRANSFORMATION.getXpath(unitLanguage,"method") + ")[" + std::to_string(i + 1) + "]";
-        methodModel m = methodModel(methodArchive, methodUnit, methodXpath, unitLanguage, "", unitNumber);
-        
-        
-        methods.push_back(m); 
+        methods.emplace_back(methodArchive, methodUnit, methodXpath, unitLanguage, "", unitNumber);
         
         free(unparsed);       
         srcml_unit_free(methodUnit);
@@ -451,9 +461,7 @@ void classModel::findMethodInProperty(srcml_archive* archive, srcml_unit* unit,
                 std::string methodXpath = "((" + classXpath + XPATH_TRANSFORMATION.getXpath(unitLanguage,"property") + ")[" + std::to_string(i + 1) + "]";
                 methodXpath += "//src:function)[" + std::to_string(j + 1) + "]";
 
-                methodModel m = methodModel(methodArchive, methodUnit, methodXpath, unitLanguage, typeUnparsed, unitNumber);
-
-                methods.push_back(m); 
+                methods.emplace_back(methodArchive, methodUnit, methodXpath, unitLanguage, typeUnparsed, unitNumber);
 
                 free(methodUnparsed);       
                 srcml_unit_free(methodUnit);
@@ -479,94 +487,75 @@ void classModel::findMethodInProperty(srcml_archive* archive, srcml_unit* unit,
 //  Based on definition from Dragan, Collard, Maletic ICSM 2010
 // Constructors and destructors are not considered in the computation of class stereotypes
 // 
-void classModel::computeClassStereotype() {
-    std::unordered_map<std::string, int> methodStereotypes = {
-        {"get", 0},
-        {"predicate", 0},
-        {"property", 0},
-        {"void-accessor", 0},
-        {"set", 0},
-        {"command", 0},
-        {"non-void-command", 0},
-        {"collaborator", 0},
-        {"controller", 0},
-        {"wrapper", 0},
-        {"factory", 0},
-        {"incidental", 0},
-        {"stateless", 0},  
-        {"empty", 0},
-        {"unclassified", 0},
-    };
+void classModel::computeClassStereotype(const methodFeatures& features, std::size_t first) {
+    int methodStereotypes[NUM_METHOD_STEREOTYPES];
     int nonCollaborators = 0;
-    for (const auto& m : methods) {      
-        if (!m.IsConstructorDestructorUsed()) {
-            for (const std::string& s : m.getStereotypeList()) 
-                methodStereotypes[s]++;
-        
-            std::string methodStereotype = m.getStereotype();
-            if (methodStereotype.find("collaborator") == std::string::npos &&
-                methodStereotype.find("controller") == std::string::npos && 
-                methodStereotype.find("wrapper") == std::string::npos)
-                    nonCollaborators++;
-        }
+    features.countStereotypes(first, methods.size(), methodStereotypes, nonCollaborators);
+
+    // Methods defined in units that are not in the input archive (project index)
+    const std::uint32_t collaboratorMask = (1u << STEREOTYPE_COLLABORATOR) | (1u << STEREOTYPE_CONTROLLER) | (1u << STEREOTYPE_WRAPPER);
+    for (const auto& external : externalMethodStereotypes) {
+        for (int s = 0; s < NUM_METHOD_STEREOTYPES; ++s)
+            methodStereotypes[s] += external.second.has(s);
+        if (!external.second.hasAny(collaboratorMask)) nonCollaborators++;
     }
 
-    int getters = methodStereotypes["get"];
-    int accessors = getters + methodStereotypes["predicate"] +
-                    methodStereotypes["property"] +
-                    methodStereotypes["void-accessor"]; 
+    int getters = methodStereotypes[STEREOTYPE_GET];
+    int accessors = getters + methodStereotypes[STEREOTYPE_PREDICATE] +
+                    methodStereotypes[STEREOTYPE_PROPERTY] +
+                    methodStereotypes[STEREOTYPE_VOID_ACCESSOR]; 
 
-    int setters = methodStereotypes["set"];     
-    int commands = methodStereotypes["command"] + methodStereotypes["non-void-command"];           
+    int setters = methodStereotypes[STEREOTYPE_SET];     
+    int commands = methodStereotypes[STEREOTYPE_COMMAND] + methodStereotypes[STEREOTYPE_NON_VOID_COMMAND];           
     int mutators = setters + commands;
 
-    int controllers = methodStereotypes["controller"];
-    int collaborator =  methodStereotypes["collaborator"] + methodStereotypes["wrapper"]; 
+    int controllers = methodStereotypes[STEREOTYPE_CONTROLLER];
+    int collaborator =  methodStereotypes[STEREOTYPE_COLLABORATOR] + methodStereotypes[STEREOTYPE_WRAPPER]; 
     int collaborators = controllers + collaborator;
     
-    int factory = methodStereotypes["factory"];
+    int factory = methodStereotypes[STEREOTYPE_FACTORY];
 
-    int degenerates = methodStereotypes["incidental"] + methodStereotypes["stateless"] + methodStereotypes["empty"];
+    int degenerates = methodStereotypes[STEREOTYPE_INCIDENTAL] + methodStereotypes[STEREOTYPE_STATELESS] + methodStereotypes[STEREOTYPE_EMPTY];
 
-    int allMethods = methods.size() - constructorDestructorCount;
+    int allMethods = methods.size() + externalMethodStereotypes.size() - constructorDestructorCount;
 
     // Entity
     if (((accessors - getters) != 0) && ((mutators - setters)  != 0) ) {
         double ratio = double(collaborators) / double(nonCollaborators);
         if (ratio >= 2 && controllers == 0) 
-            stereotype.push_back("entity");   
+            stereotype.add(CLASS_STEREOTYPE_ENTITY);   
     }
 
     // Minimal Entity
     if (((allMethods - (getters + setters + commands)) == 0) && (getters != 0) && (setters != 0) & (commands != 0)) {
         double ratio = double(collaborators) / double(nonCollaborators);
         if (ratio >= 2) 
-            stereotype.push_back("minimal-entity");   
+            stereotype.add(CLASS_STEREOTYPE_MINIMAL_ENTITY);   
     }
 
     // Data Provider
     if ((accessors > 2 * mutators) && (accessors > 2 * (controllers + factory)) )
-        stereotype.push_back("data-provider");
+        stereotype.add(CLASS_STEREOTYPE_DATA_PROVIDER);
 
     // Commander
     if ((mutators > 2 * accessors) && (mutators > 2 * (controllers + factory)))
-        stereotype.push_back("commander");
+        stereotype.add(CLASS_STEREOTYPE_COMMANDER);
 
     // Boundary
     if ((collaborators > nonCollaborators) && (factory < 0.5 * allMethods) && (controllers < 0.33 * allMethods))
-        stereotype.push_back("boundary");
+        stereotype.add(CLASS_STEREOTYPE_BOUNDARY);
 
     // Factory
     if (factory > 0.67 * allMethods)
-        stereotype.push_back("factory");
+        stereotype.add(CLASS_STEREOTYPE_FACTORY);
     
     // Controller
     if ((controllers + factory > 0.67 * allMethods) && ((accessors != 0) || (mutators != 0)))
-        stereotype.push_back("controller");
+        stereotype.add(CLASS_STEREOTYPE_CONTROLLER);
 
     // Pure Controller
     if ((controllers + factory != 0) && ((accessors + mutators + collaborator) == 0) && (controllers != 0)) 
-        stereotype.push_back("pure-controller");
+        stereotype.add(CLASS_STEREOTYPE_PURE_CONTROLLER);
 
     // Large Class
     {
@@ -576,7 +565,7 @@ void classModel::computeClassStereotype() {
             ((0.2 * allMethods < facPlusCon) && (facPlusCon < 0.67 * allMethods )) &&
             (factory != 0) && (controllers != 0) && (accessors != 0) && (mutators != 0) ) {
                 if (allMethods > METHODS_PER_CLASS_THRESHOLD) { 
-                    stereotype.push_back("large-class");
+                    stereotype.add(CLASS_STEREOTYPE_LARGE_CLASS);
             }
         }
     }
@@ -584,27 +573,27 @@ void classModel::computeClassStereotype() {
     // Lazy Class
     if ((getters + setters != 0) && (((degenerates / double(allMethods)) > 0.33)) &&
        (((allMethods - (degenerates + getters + setters)) / double(allMethods))  <= 0.2))
-        stereotype.push_back("lazy-class");
+        stereotype.add(CLASS_STEREOTYPE_LAZY_CLASS);
     
     // Degenerate Class
     if ((degenerates / double(allMethods)) > 0.5)  
-        stereotype.push_back("degenerate");
+        stereotype.add(CLASS_STEREOTYPE_DEGENERATE);
     
     // Data Class
     if ((allMethods - (getters + setters) == 0) && ((getters + setters) != 0))
-         stereotype.push_back("data-class");
+         stereotype.add(CLASS_STEREOTYPE_DATA_CLASS);
     
     // Small Class
     if ((0 < allMethods) && (allMethods < 3))
-        stereotype.push_back("small-class");
+        stereotype.add(CLASS_STEREOTYPE_SMALL_CLASS);
 
     // Empty Class (Considered degenerate)
     if (allMethods == 0)
-        stereotype.push_back("empty");
+        stereotype.add(CLASS_STEREOTYPE_EMPTY);
 
     // Final check if no stereotype was assigned
-    if (stereotype.size() == 0) 
-        stereotype.push_back("unclassified");
+    if (stereotype.empty()) 
+        stereotype.add(CLASS_STEREOTYPE_UNCLASSIFIED);
 
     for (const auto& pair : xpath) 
         for (const auto& classXpath : pair.second) 
@@ -613,378 +602,281 @@ void classModel::computeClassStereotype() {
 }
 
 //Compute method stereotypes
+// The rules are applied to all methods by methodFeatures::classifyMethods(). This sets the stereotypes
+//  of the methods from the rows of the class in features (starting at first)
 //
-void classModel::computeMethodStereotype() {
-    constructorDestructor();
-    getter();
-    predicate();
-    property();
-    voidAccessor(); 
-    setter();
-    command();
-    factory();
-    wrapperControllerCollaborator();
-    incidental();
-    stateless();
-    empty();
-    for (auto& m : methods) { 
-        if (m.getStereotypeList().size() == 0) 
-             m.setStereotype("unclassified");
-        XPATH_LIST[m.getUnitNumber()].insert({m.getXpath(), m.getStereotype()});    
+void classModel::computeMethodStereotype(const methodFeatures& features, std::size_t first) {
+    for (std::size_t i = 0; i < methods.size(); ++i) {
+        methods[i].setStereotype(stereotypeSet(STEREOTYPE_KIND_METHOD, features.stereotype[first + i]));
+
+        if (features.constructorDestructor[first + i]) constructorDestructorCount++;
+        XPATH_LIST[methods[i].getUnitNumber()].insert({methods[i].getXpath(), methods[i].getStereotype()});    
     }
 }
 
-// Stereotype constructor copy-constructor destructor:
+// Adds a row to features for each method of the class
 //
-void classModel::constructorDestructor() {
-    for (auto& m : methods) {
-        if (m.IsConstructorDestructorUsed()) {  
-            constructorDestructorCount++;
-            const std::string& parameterList = m.getParametersList();
-            const std::string& srcML = m.getSrcML();
-
-            if (srcML.find("<destructor>") != std::string::npos)
-                m.setStereotype("destructor"); 
-            else if (parameterList.find(name[3]) != std::string::npos) 
-                m.setStereotype("copy-constructor");
-            else 
-                m.setStereotype("constructor");
-        }
-    }
+void classModel::addMethodFeatures(methodFeatures& features, int classId) const {
+    for (const auto& m : methods)
+        features.addMethod(m, classId, name[3], unitLanguage);
 }
 
-// Stereotype get:
-// 1] Return type is not void
-// 2] Contains at least one simple return expression that returns an attribute (e.g., return dm;)
-// "this" keyword by itself is not considered (e.g., return this;)
+// Appends another part of a partial class (C#) that was collected from a different unit
+// Used by watch mode and by the streaming mode index, where the facts of each unit are collected separately
 //
-void classModel::getter() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            if (m.IsAttributeReturned()) {
-                m.setStereotype("get");
-            }
-        }
-    }
+void classModel::appendPartialClass(const classModel& part) {
+    for (const auto& pair : part.xpath)
+        xpath[pair.first].insert(xpath[pair.first].end(), pair.second.begin(), pair.second.end());
+
+    parentClassName.insert(part.parentClassName.begin(), part.parentClassName.end());
+    attributes.insert(part.attributes.begin(), part.attributes.end());
+    writable(nonPrivateAttributes).insert(part.nonPrivateAttributes->begin(), part.nonPrivateAttributes->end());
+    writable(methodSignatures).insert(part.methodSignatures->begin(), part.methodSignatures->end());
+    for (const auto& m : part.methods)
+        methods.push_back(m.clone());
 }
 
-// Stereotype predicate:
-// 1] Return type is Boolean
-// 2] Contains at least one complex return expression
-// 3] Uses a data member in an expression or has at least 
-//     one function call to other methods in class
+// Clears class and method stereotypes so they can be computed again
 //
-// Constructor calls are not considered
-// Ignored calls are not considered
-// "this" keyword by itself is considered
-// 
-void classModel::predicate() { 
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            bool returnType = false;
-            const std::string& returnTypeParsed = m.getReturnTypeParsed();
-
-            if (unitLanguage == "C++")
-                returnType = (returnTypeParsed == "bool");
-            else if (unitLanguage == "C#")
-                returnType = (returnTypeParsed == "bool") || 
-                            (returnTypeParsed == "Boolean");
-            else if (unitLanguage == "Java")
-                returnType = (returnTypeParsed == "boolean");
-
-            bool hasComplexReturnExpr = m.IsAttributeNotReturned();
-            bool isAttributeUsed = m.IsAttributeUsed();
-            bool callsToOtherClassMethods = m.getFunctionCalls().size() > 0;
-
-            if (returnType && hasComplexReturnExpr && (isAttributeUsed || callsToOtherClassMethods))
-                m.setStereotype("predicate"); 
-        }
-    }
+void classModel::resetStereotype() {
+    stereotype.clear();
+    constructorDestructorCount = 0;
+    for (auto& m : methods)
+        m.clearStereotype();
 }
 
-// Stereotype property:
-// 1] Return type is not void or Boolean
-// 2] Contains at least one complex return statement (e.g., return a+5;)
-// 3] Uses a data member in an expression or has at least 
-//     one function call to other methods in class
+// Merges the method signatures of the class and of all parent classes into one set
+// Used while the methods of the class are analyzed, so a call is resolved with a single lookup
 //
-// Constructor calls are not considered
-// Ignored calls are not considered
-// "this" keyword by itself is considered
-//  
-void classModel::property() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed() && !m.IsStrictFactory()) {  
-            bool returnNotVoidOrBool = false;
-            const std::string& returnTypeParsed = m.getReturnTypeParsed();
-
-
-            bool isVoidPointer = false;
-            if (unitLanguage != "Java") {  
-                if (m.getReturnType().find("void*") != std::string::npos)
-                    isVoidPointer = true;
-            }
-
-            if (unitLanguage == "C++")
-                returnNotVoidOrBool = (returnTypeParsed != "bool" && returnTypeParsed != "void" && returnTypeParsed != "") || isVoidPointer;
-            else if (unitLanguage == "C#")
-                returnNotVoidOrBool = (returnTypeParsed != "bool" && returnTypeParsed != "Boolean" &&
-                            returnTypeParsed != "void" && returnTypeParsed != "Void" && returnTypeParsed != "") || isVoidPointer;
-            else if (unitLanguage == "Java")
-                returnNotVoidOrBool = (returnTypeParsed != "boolean" && returnTypeParsed != "void" && 
-                            returnTypeParsed != "Void" && returnTypeParsed != "");
-
-            bool isAttributeUsed = m.IsAttributeUsed();
-            bool callsToOtherClassMethods = m.getFunctionCalls().size() > 0;
-
-            if (returnNotVoidOrBool && m.IsAttributeNotReturned() && (isAttributeUsed || callsToOtherClassMethods)) {
-                m.setStereotype("property");
-            }
-        }
-    }
+void classModel::findMethodSignatures(symbolSet& signatures) const {
+    signatures.insert(methodSignatures->begin(), methodSignatures->end());
+    for (const auto& layer : inheritedMethodSignatures)
+        signatures.insert(layer->begin(), layer->end());
 }
 
-// Stereotype void-accessor:
-// 1] Return type is void 
-// 2] Contains at least one parameter that is passed by non-const reference and is assigned a value
-// 3] Uses a data member in an expression or has at least 
-//     one function call to other methods in class 
-//
-// Constructor calls are not considered
-// Ignored calls are not considered
-// "this" keyword by itself is considered
+// Merges attributes with the inherited layers (used when the class is written)
+// Attributes from the layers are flagged as inherited. On a name clash, the 
+//  attribute of the class wins over the layers, and a layer wins over the layers after it
 //
-void classModel::voidAccessor() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            bool isAttributeUsed = m.IsAttributeUsed();
-            bool callsToOtherClassMethods = m.getFunctionCalls().size() > 0;
-
-            bool isVoidPointer = false;
-            if (unitLanguage != "Java") {              
-                if (m.getReturnType().find("void*") != std::string::npos)
-                    isVoidPointer = true;
-            }
-
-            bool returnVoid = m.getReturnTypeParsed() == "void";
-
-            if (m.IsParameterRefChanged() && returnVoid && !isVoidPointer && 
-               (isAttributeUsed || callsToOtherClassMethods)) {
-                m.setStereotype("void-accessor");       
-            } 
+variableMap classModel::flattenAttributes(const variableMap& own, const std::vector<attributeLayer>& layers) {
+    variableMap flattened(own);
+    for (const auto& layer : layers) {
+        for (const auto& pair : *layer) {
+            auto result = flattened.insert(pair);
+            if (result.second) result.first->second.setInherited(true);
         }
     }
+    return flattened;
 }
 
-// Stereotype set:
-// 1] Only one data member is changed
-// 2] Number of calls on data members or to methods in class is at most 1
-//
-// Constructor calls are not considered
-// Ignored calls are not considered
-// "this" keyword by itself is considered
+symbolSet classModel::flattenSignatures(const std::vector<signatureLayer>& layers) {
+    symbolSet flattened;
+    for (const auto& layer : layers)
+        flattened.insert(layer->begin(), layer->end());
+    return flattened;
+}
+
+// Writes the class to the project index
+// Attributes and method signatures are written after inheritance, so
+//  the parent classes are not needed when the index is loaded
+// Stereotypes of methods are kept to compute the class stereotype
+//  when methods are defined in other units (e.g., C++ methods defined externally)
 //
-void classModel::setter() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            bool oneAttributeModified = m.getNumOfAttributesModified() == 1;
-            int callsToClassMethodsOrOnAttributes = m.getFunctionCalls().size() + m.getMethodCalls().size();
-            
-            if (oneAttributeModified && (callsToClassMethodsOrOnAttributes <= 1)) 
-                m.setStereotype("set"); 
-        }   
+void classModel::writeIndex(std::ostream& out, const std::unordered_map<int, std::string>& unitFilenames) const {
+    writeString(out, unitLanguage);
+    writeString(out, structureType);
+    writeStringList(out, name);
+    writeStringMap(out, parentClassName);
+    writeVariableMap(out, flattenAttributes(attributes, inheritedAttributes));
+    writeVariableMap(out, flattenAttributes(*nonPrivateAttributes, nonPrivateInheritedAttributes));
+    writeSymbolSet(out, *methodSignatures);
+    writeSymbolSet(out, flattenSignatures(inheritedMethodSignatures));
+
+    std::int64_t count = externalMethodStereotypes.size();
+    for (const auto& m : methods)
+        if (!m.IsConstructorDestructorUsed()) ++count;
+
+    writeInteger(out, count);
+    for (const auto& m : methods) {
+        if (m.IsConstructorDestructorUsed()) continue;
+        auto filename = unitFilenames.find(m.getUnitNumber());
+        writeString(out, filename != unitFilenames.end() ? filename->second : "");
+        writeStringList(out, m.getStereotypeSet().getNames());
+    }
+    for (const auto& external : externalMethodStereotypes) {
+        writeString(out, external.first);
+        writeStringList(out, external.second.getNames());
     }
 }
 
-// stereotype command:
-//     Method has a void return type
-//     Cases:
-//          Case 1: More than one data member is modifed
-//          Case 2: one data member is modifed and:
-//                  -	There is at least two calls on data members or
-//                      function calls to other methods in class
-//          Case 3: zero data members modifed and:
-//                  -	there is at least one call on a data member
-//                      or one function call to other methods in clasa
-//     Method is not const (C++ only)
-//     Case 1 applies when attributes are mutable and method is const (C++ only)
-//
-//    Constructor calls are not considered
-//    Ignored calls are not considered
-//    "this" keyword by itself is considered
+// Writes the class to a module summary
+// Same layout as the project index, but only the parts needed by child classes
+//  in other modules are kept (non-private and inherited attributes, and method signatures)
 //
-// stereotype non-void-command (C++ only):        
-//    Method return type is not void
+void classModel::writeSummary(std::ostream& out) const {
+    writeString(out, unitLanguage);
+    writeString(out, structureType);
+    writeStringList(out, name);
+    writeStringMap(out, parentClassName);
+    variableMap nonPrivateAndInheritedAttributes = flattenAttributes(*nonPrivateAttributes, nonPrivateInheritedAttributes);
+    writeVariableMap(out, nonPrivateAndInheritedAttributes);
+    writeVariableMap(out, nonPrivateAndInheritedAttributes);
+    writeSymbolSet(out, *methodSignatures);
+    writeSymbolSet(out, flattenSignatures(inheritedMethodSignatures));
+    writeInteger(out, 0);
+}
+
+// Reads a class from the project index or from a module summary
+// The class is already inherited
 //
-void classModel::command() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            const std::string& returnTypeParsed = m.getReturnTypeParsed();
-            int attributeModified = m.getNumOfAttributesModified();
-            int callsToMethodsInClass = m.getFunctionCalls().size() ; 
-            int callsOnDataMembers = m.getMethodCalls().size();
-
-            bool case1 = attributeModified == 0 && (callsToMethodsInClass > 0 || callsOnDataMembers > 0);
-            bool case2 = attributeModified == 1 && ((callsOnDataMembers + callsToMethodsInClass) > 1);
-            bool case3 = attributeModified > 1;
-            bool mutableCase = m.IsConstMethod() && case3;
- 
-            bool isVoidPointer = false;
-            if (unitLanguage != "Java") {  
-                if (m.getReturnType().find("void*") != std::string::npos)
-                    isVoidPointer = true;
-            }
-            
-            bool returnCheck = returnTypeParsed != "void" && returnTypeParsed != "Void" && !isVoidPointer;
-
-            if (case1 || case2 || case3) {
-                if (!m.IsConstMethod() || mutableCase){ // Handles case of mutable attributes (C++ only)
-                    if (returnCheck)
-                        m.setStereotype("non-void-command");  
-                    else
-                        m.setStereotype("command");
-                }
-            } 
-        }
+void classModel::readIndex(std::istream& in) {
+    unitLanguage = readString(in);
+    structureType = readString(in);
+    name = readStringList(in);
+    parentClassName = readStringMap(in);
+    // Inherited attributes and method signatures are already merged in the index, so 
+    //  the class has no layers and its non-private attributes include the inherited ones
+    attributes = readVariableMap(in);
+    nonPrivateAttributes = std::make_shared<variableMap>(readVariableMap(in));
+    methodSignatures = std::make_shared<symbolSet>(readSymbolSet(in));
+    inheritedMethodSignatures.assign(1, std::make_shared<const symbolSet>(readSymbolSet(in)));
+
+    std::int64_t count = readInteger(in);
+    for (std::int64_t i = 0; in && i < count; ++i) {
+        std::string filename = readString(in);
+        stereotypeSet methodStereotype(STEREOTYPE_KIND_METHOD);
+        for (const std::string& name : readStringList(in))
+            methodStereotype.add(name);
+        externalMethodStereotypes.push_back({filename, methodStereotype});
     }
+
+    if (name.size() != 4) {
+        in.setstate(std::ios::failbit);
+        name = {"", "", "", ""};
+    }
+    inherited = true;
 }
 
-// Stereotype factory
-// 1] Factories must include a non-primitive type in their return type
-//      and their return expression must be a local variable, parameter, or attribute, that 
-//      call a constructor call or has a return expression with a constructor call (e.g., new)
+// Adds the data of the same class from the project index
+// Needed when parts of the class are defined in other units (e.g., partial classes in C#
+//  or methods defined externally in C++). Data from the input archive takes precedence
 //
-// Variables created with ignored calls are considered
-// Returns that have "new" ignored calls are also considered
-// "this" keyword by itself is not considered
+void classModel::mergeIndex(const classModel& indexed, const std::unordered_set<std::string>& inputFilenames) {
+    attributes.insert(indexed.attributes.begin(), indexed.attributes.end());
+    writable(nonPrivateAttributes).insert(indexed.nonPrivateAttributes->begin(), indexed.nonPrivateAttributes->end());
+    writable(methodSignatures).insert(indexed.methodSignatures->begin(), indexed.methodSignatures->end());
+    for (const auto& layer : indexed.inheritedMethodSignatures)
+        addLayer(inheritedMethodSignatures, layer);
+
+    for (const auto& external : indexed.externalMethodStereotypes)
+        if (inputFilenames.find(external.first) == inputFilenames.end())
+            externalMethodStereotypes.push_back(external);
+}
+
+// Removes methods of units that are in the input archive, since they are analyzed again
 //
-void classModel::factory() {
-    for (auto& m : methods) {
-        if (m.IsFactory() || m.IsStrictFactory()) m.setStereotype("factory");
+void classModel::removeExternalMethods(const std::unordered_set<std::string>& inputFilenames) {
+    for (auto it = externalMethodStereotypes.begin(); it != externalMethodStereotypes.end();) {
+        if (inputFilenames.find(it->first) != inputFilenames.end()) it = externalMethodStereotypes.erase(it);
+        else ++it;
     }
 }
-// Stereotype wrapper:
-// 1] No data members are modified
-// 2] No calls to methods in class
-// 3] No calls on data members
-// 4] Has at least one free function call 
-// Constructor calls are not considered
-//
-// Stereotype controller:
-// 1] No data members are modified
-// 2] No calls to methods in class
-// 3] No calls on data members
-// 3] Has at least one call to other class methods or mutates a parameter or a local that is non-primitive
-//
-// Stereotype collaborator:
-// 1] It must use at least 1 non-primitive type (not of this class)
-// 2] Type could be a parameter, local variable, return type, or an attribute 
+
+// Approximate memory held by the methods in memory (used by --max-memory)
 //
-// Ignored calls are not considered
-// "this" keyword by itself is considered only for wrapper and controller
+std::size_t classModel::getMemorySize() const {
+    std::size_t size = 0;
+    for (const auto& m : methods)
+        size += m.getMemorySize();
+    return size;
+}
+
+// Writes the methods in memory to the spill file and frees them (--max-memory)
+// Methods are written with the checkpoint format. If they were not changed since they were 
+//  read back, only the methods added after are written
+// Method signatures are built first if inheritance is not found yet, since it is found without the methods
 //
-void classModel::wrapperControllerCollaborator() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            if (!m.IsEmpty()){
-                bool nonPrimitiveAttributeExternal = m.IsNonPrimitiveAttributeExternal();
-                bool nonPrimitiveLocalExternal = m.IsNonPrimitiveLocalExternal();
-                bool nonPrimitiveParamaterExternal = m.IsNonPrimitiveParamaterExternal();
-                bool nonPrimitiveReturnExternal = m.IsNonPrimitiveReturnTypeExternal();
-            
-                bool isVoidPointer = false;
-                if (unitLanguage != "Java") {  
-                    if (m.getReturnType().find("void*") != std::string::npos )
-                        isVoidPointer = true;
-                }
-
-                bool returnCheck = nonPrimitiveReturnExternal || isVoidPointer;
-
-                bool noAttributeModified = m.getNumOfAttributesModified() == 0;
-                bool noCallsToMethodsInClass = m.getFunctionCalls().size() == 0; 
-                bool noCallsOnDataMembers = m.getMethodCalls().size() == 0;
-                bool hasFreeFunctionCalls = m.getNumOfExternalFunctionCalls() > 0;
-                bool hasCallsToOtherClassMethods = m.getNumOfExternalMethodCalls() > 0;
-        
-                if (noAttributeModified && noCallsToMethodsInClass && noCallsOnDataMembers && !hasCallsToOtherClassMethods && hasFreeFunctionCalls)
-                    m.setStereotype("wrapper");
+void classModel::spillMethods(std::ostream& out, bool changed) {
+    if (!inherited) buildMethodSignature();
+    bool rewrite = changed && loadedMethods > 0;
+    std::size_t first = rewrite ? 0 : loadedMethods;
+    if (rewrite) spilledMethods.clear();
+    if (first < methods.size()) spilledMethods.push_back(writeSpilledMethods(out, methods, first));
+    methods = std::vector<methodModel>();
+    loadedMethods = 0;
+}
 
-                else if (noAttributeModified && noCallsToMethodsInClass && noCallsOnDataMembers &&
-                        (hasCallsToOtherClassMethods || m.IsNonPrimitiveLocalOrParameterChanged()))
-                    m.setStereotype("controller");   
+// Reads the spilled methods back before the methods in memory (--max-memory)
+// The methods stay in the spill file until they are changed and spilled again
+//
+void classModel::loadMethods(std::istream& in) {
+    if (loadedMethods > 0 || spilledMethods.empty()) return;
 
-                else if (nonPrimitiveAttributeExternal || nonPrimitiveLocalExternal || nonPrimitiveParamaterExternal || returnCheck )
-                    m.setStereotype("collaborator");   
-            }
-        }
-    }
-}
+    std::vector<methodModel> loaded;
+    for (std::int64_t offset : spilledMethods)
+        readSpilledMethods(in, offset, loaded);
 
-// Stereotype incidental 
-// 1] Method contains at least one non-comment statement (i.e., method is not empty)
-// 2] No data members are used or modified (including no use of keyword "this" by itself)
-// 3] No calls of any kind
-// Ignored calls are allowed
-// 
-void classModel::incidental() {
-    for (auto& m : methods ) {
-        if (!m.IsConstructorDestructorUsed() && !m.IsEmpty()) {  
-            bool noCalls = m.getFunctionCalls().size() == 0 && m.getMethodCalls().size() == 0 && m.getConstructorCalls().size() == 0 &&
-                           m.getNumOfExternalMethodCalls() == 0 && m.getNumOfExternalFunctionCalls() == 0;
-
-            if (!m.IsAttributeUsed() && noCalls)
-                m.setStereotype("incidental");         
-            
-        }
-    }
+    loadedMethods = loaded.size();
+    for (auto& m : methods)
+        loaded.push_back(std::move(m));
+    methods = std::move(loaded);
 }
 
-// Stereotype stateless
-// 1]	Method contains at least one non-comment statement (i.e., method is not empty)
-// 2]	No data members are used or modified (including no use of keyword "this" by itself)
-// 3]	No calls to methods in class 
-// 4]   No calls on data members
-// 5]   Has at least one call to other class methods (including constructor calls) or to a free function 
-// Ignored calls are not considered
+// Writes all data of the class (used by checkpoints)
 //
-void classModel::stateless() {
-    for (auto& m : methods) {
-        if (m.getName() == "InitializeWithWindow")
-            std::cout << "yes";
-        if (!m.IsConstructorDestructorUsed()) {  
-            if (!m.IsEmpty()) {
-                bool noCallsToClassMethodsOrOnAttributes = m.getFunctionCalls().size() == 0 && m.getMethodCalls().size() == 0;
-                bool hasFreeFunctionCalls = m.getNumOfExternalFunctionCalls() > 0;
-                bool hasCallsToOtherClassMethods = m.getNumOfExternalMethodCalls() > 0; 
-                bool hasConstructorCalls = m.getConstructorCalls().size() > 0;
-
-                if (!m.IsAttributeUsed() && noCallsToClassMethodsOrOnAttributes &&
-                (hasFreeFunctionCalls || hasCallsToOtherClassMethods || hasConstructorCalls))
-                    m.setStereotype("stateless");             
-            }
-        }
+void classModel::writeCheckpoint(std::ostream& out) const {
+    writeStringList(out, name);
+    writeStringMap(out, parentClassName);
+    writeString(out, structureType);
+    writeString(out, unitLanguage);
+    writeStereotypeSet(out, stereotype);
+    writeInteger(out, methods.size());
+    for (const auto& m : methods) m.writeCheckpoint(out);
+    writeSymbolSet(out, *methodSignatures);
+    writeSymbolSet(out, flattenSignatures(inheritedMethodSignatures));
+    writeVariableMap(out, flattenAttributes(attributes, inheritedAttributes));
+    writeVariableMap(out, flattenAttributes(*nonPrivateAttributes, nonPrivateInheritedAttributes));
+    writeXpathMap(out, xpath);
+    writeInteger(out, inherited);
+    writeInteger(out, visited);
+    writeInteger(out, constructorDestructorCount);
+    writeInteger(out, externalMethodStereotypes.size());
+    for (const auto& external : externalMethodStereotypes) {
+        writeString(out, external.first);
+        writeStereotypeSet(out, external.second);
     }
 }
 
-// Stereotype empty
-// 1] Method has no statements except for comments
+// Reads all data of the class written by writeCheckpoint()
 //
-void classModel::empty() {
-    for (auto& m : methods) {
-        if (!m.IsConstructorDestructorUsed()) {  
-            if (m.IsEmpty()) 
-                m.setStereotype("empty");
-        }
+void classModel::readCheckpoint(std::istream& in) {
+    name = readStringList(in);
+    parentClassName = readStringMap(in);
+    structureType = readString(in);
+    unitLanguage = readString(in);
+    stereotype = readStereotypeSet(in);
+    std::int64_t count = readInteger(in);
+    for (std::int64_t i = 0; in && i < count; ++i) {
+        methods.emplace_back();
+        methods.back().readCheckpoint(in);
+    }
+    // Layers are merged when written, so they are read back as a single layer (as in readIndex())
+    methodSignatures = std::make_shared<symbolSet>(readSymbolSet(in));
+    inheritedMethodSignatures.assign(1, std::make_shared<const symbolSet>(readSymbolSet(in)));
+    attributes = readVariableMap(in);
+    nonPrivateAttributes = std::make_shared<variableMap>(readVariableMap(in));
+    xpath = readXpathMap(in);
+    inherited = readInteger(in) != 0;
+    visited = readInteger(in) != 0;
+    constructorDestructorCount = readInteger(in);
+    count = readInteger(in);
+    for (std::int64_t i = 0; in && i < count; ++i) {
+        std::string filename = readString(in);
+        externalMethodStereotypes.push_back({filename, readStereotypeSet(in)});
     }
-}
-
-std::string classModel::getStereotype () const {
-    std::string result;
-
-    for (const std::string &value : stereotype)
-        result += value + " ";
 
-    Rtrim(result);
-     
-    return result;
+    if (name.size() != 4) {
+        in.setstate(std::ios::failbit);
+        name = {"", "", "", ""};
+    }
 }
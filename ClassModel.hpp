@@ -11,10 +11,22 @@
 #define CLASSMODEL_HPP
 
 #include "MethodModel.hpp"
+#include "MethodFeatures.hpp"
+#include "Serialization.hpp"
+
+// Method signatures of a class as seen by its child classes (never modified once shared)
+//
+using signatureLayer = std::shared_ptr<const symbolSet>;
 
 class classModel {
 public:
+         classModel                         () = default;
          classModel                         (srcml_archive*, srcml_unit*, const std::string&);
+         classModel                         (classModel&&) = default;
+         classModel& operator=              (classModel&&) = default;
+
+    // Classes are moved, not copied (each holds all of its methods). Copies are explicit
+    classModel clone                        () const                       { return classModel(*this); }
          
     void findClassName                      (srcml_archive*, srcml_unit*);
     void findStructureType                  (srcml_archive*, srcml_unit*);
@@ -27,78 +39,129 @@ public:
     void findMethodInProperty               (srcml_archive*, srcml_unit*, const std::string&, int);
     void findClassData                      (srcml_archive*, srcml_unit*, const std::string&, int);
 
-    void computeClassStereotype();
-    void computeMethodStereotype();
-
-    void constructorDestructor();
-    void getter();
-    void setter();
-    void predicate();
-    void property();
-    void voidAccessor();
-    void command();
-    void wrapperControllerCollaborator();
-    void factory();
-    void incidental();
-    void stateless();
-    void empty();
+    void computeClassStereotype             (const methodFeatures&, std::size_t);
+    void computeMethodStereotype            (const methodFeatures&, std::size_t);
+    void addMethodFeatures                  (methodFeatures&, int) const;
     
-    std::string                                            getStereotype                      ()               const;
+    const std::string&                                     getStereotype                      ()               const          { return stereotype.getString();                 }
     const std::string&                                     getUnitLanguage                    ()               const          { return unitLanguage;                           }
-    std::unordered_map<std::string, variable>&             getAttribute                       ()                              { return attributes;                             }
+    variableMap&                                           getAttribute                       ()                              { return attributes;                             }
     std::vector<methodModel>&                              getMethods                         ()                              { return methods;                                }
+    const std::vector<methodModel>&                        getMethods                         ()               const          { return methods;                                }
 
     const std::vector<std::string>&                        getName                            ()               const          { return name;                                   }
-    const std::vector<std::string>&                        getStereotypeList                  ()               const          { return stereotype;                             }
-    const std::unordered_map<std::string, std::string>&    getParentClassName                 ()               const          { return parentClassName;                        }
-    const std::unordered_map<std::string, variable>&       getNonPrivateAndInheritedAttribute ()               const          { return nonPrivateAndInheritedAttributes;       }
-    const std::unordered_set<std::string>&                 getInheritedMethodSignatures       ()               const          { return inheritedMethodSignatures;              }    
-    const std::unordered_set<std::string>&                 getMethodSignatures                ()               const          { return methodSignatures;                       }    
+    const stereotypeSet&                                   getStereotypeSet                   ()               const          { return stereotype;                             }
+    const flatStringMap<std::string>&                      getParentClassName                 ()               const          { return parentClassName;                        }
+    const std::vector<attributeLayer>&                     getInheritedAttribute              ()               const          { return inheritedAttributes;                    }
+    const std::unordered_map<int, std::vector<std::string>>& getXpath                         ()               const          { return xpath;                                  }
     
     bool                                                   HasInherited                       ()               const          { return inherited;                              }
     bool                                                   IsVisited                          ()               const          { return visited;                                }
+    bool                                                   HasLoadedMethods                   ()               const          { return loadedMethods > 0;                      }
     
     void                                                   setInherited                       (bool flag)                     { inherited = flag;                              }
     void                                                   setVisited                         (bool flag)                     { visited = flag;                                }
 
-    void addMethod(methodModel& m)  {
-        methods.push_back(m); 
+    void addMethod(methodModel&& m)  {
+        methods.push_back(std::move(m)); 
     }
 
-    void inheritAttribute(const std::unordered_map<std::string, variable>& inheritedNonPrivateAttribute, 
-                          const std::string& inheritanceSpecifier) { 
-        attributes.insert(inheritedNonPrivateAttribute.begin(), inheritedNonPrivateAttribute.end());
-        if (inheritanceSpecifier != "private") 
+    // Parent attributes are not copied. The child references the layer of non-private attributes of the
+    //  parent and the layers the parent passes on (only passed on again if the inheritance is not private)
+    void inheritAttribute(const classModel& parent, const std::string& inheritanceSpecifier) { 
+        addLayer(inheritedAttributes, attributeLayer(parent.nonPrivateAttributes));
+        for (const auto& layer : parent.nonPrivateInheritedAttributes)
+            addLayer(inheritedAttributes, layer);
+
+        if (inheritanceSpecifier != "private") {
             // Used to chain inheritance
-            nonPrivateAndInheritedAttributes.insert(inheritedNonPrivateAttribute.begin(), inheritedNonPrivateAttribute.end());         
+            addLayer(nonPrivateInheritedAttributes, attributeLayer(parent.nonPrivateAttributes));
+            for (const auto& layer : parent.nonPrivateInheritedAttributes)
+                addLayer(nonPrivateInheritedAttributes, layer);
+        }
     }
 
-    void appendInheritedMethod(const std::unordered_set<std::string>& parentMethods, 
-                               const std::unordered_set<std::string>& parentInheritedMethodSignature) {       
-        inheritedMethodSignatures.insert(parentInheritedMethodSignature.begin(), parentInheritedMethodSignature.end());  
-        inheritedMethodSignatures.insert(parentMethods.begin(), parentMethods.end());
+    void appendInheritedMethod(const classModel& parent) {       
+        addLayer(inheritedMethodSignatures, signatureLayer(parent.methodSignatures));
+        for (const auto& layer : parent.inheritedMethodSignatures)
+            addLayer(inheritedMethodSignatures, layer);
     }
 
     void buildMethodSignature() {
+        symbolSet& signatures = writable(methodSignatures);
         for (const auto& m : methods) 
-            methodSignatures.insert(m.getNameSignature());
+            signatures.insert(m.getNameSignatureSymbol());
+    }
+
+    void addMethodSignature(symbol signature) {
+        writable(methodSignatures).insert(signature);
     }
 
+    // Keeps only what child classes and the module summary need (streaming mode index)
+    // Method signatures are built before the methods are dropped
+    void reduceToIndex() {
+        buildMethodSignature();
+        methods = std::vector<methodModel>();
+        attributes = variableMap();
+        xpath.clear();
+    }
+
+    void findMethodSignatures(symbolSet& signatures) const;
+    void appendPartialClass(const classModel& part);
+    void resetStereotype();
+
+    void writeIndex(std::ostream& out, const std::unordered_map<int, std::string>& unitFilenames) const;
+    void writeSummary(std::ostream& out) const;
+    void readIndex(std::istream& in);
+    void mergeIndex(const classModel& indexed, const std::unordered_set<std::string>& inputFilenames);
+    void removeExternalMethods(const std::unordered_set<std::string>& inputFilenames);
+
+    void writeCheckpoint(std::ostream& out) const;
+    void readCheckpoint(std::istream& in);
+
+    std::size_t getMemorySize() const;
+    void spillMethods(std::ostream& out, bool changed);
+    void loadMethods(std::istream& in);
+
 private:
+         classModel                         (const classModel&);
+
+    // Layers are shared with child classes, so a shared layer is copied before it is modified
+    template <typename T>
+    static T& writable(std::shared_ptr<T>& layer) {
+        if (layer.use_count() > 1) layer = std::make_shared<T>(*layer);
+        return *layer;
+    }
+
+    // A layer reached through more than one parent (e.g., a diamond) is only added once
+    template <typename T>
+    static void addLayer(std::vector<T>& layers, const T& layer) {
+        if (std::find(layers.begin(), layers.end(), layer) == layers.end()) layers.push_back(layer);
+    }
+
+    static variableMap                 flattenAttributes    (const variableMap&, const std::vector<attributeLayer>&);
+    static symbolSet                   flattenSignatures    (const std::vector<signatureLayer>&);
+
     std::vector<std::string>                                name;                            // Original name, name without whitespaces, name without whitespaces, namespaces, and generic types in <>, same as last but without <>
-    std::unordered_map<std::string, std::string>            parentClassName;                 // Key is parent class name without whitespaces and namespaces and value is specifier (public, private, or protected).
+    flatStringMap<std::string>                              parentClassName;                 // Key is parent class name without whitespaces and namespaces and value is specifier (public, private, or protected).
     std::string                                             structureType;                   // Class, or struct, or an interface
     std::string                                             unitLanguage;                    // Unit language                 
-    std::vector<std::string>                                stereotype;                      // Class stereotype(s)
+    stereotypeSet                                           stereotype{STEREOTYPE_KIND_CLASS}; // Class stereotype(s)
     std::vector<methodModel>                                methods;                         // List of methods 
-    std::unordered_set<std::string>                         methodSignatures;                // List of method signatures
-    std::unordered_set<std::string>                         inheritedMethodSignatures;       // List of inherited method signatures                                           
-    std::unordered_map<std::string, variable>               attributes;                      // Key is attribute name and value is attribute object
-    std::unordered_map<std::string, variable>               nonPrivateAndInheritedAttributes;// Non-private attributes of class + inherited attributes from all parent classes
+    std::shared_ptr<symbolSet>                              methodSignatures{std::make_shared<symbolSet>()}; // List of method signatures (shared with child classes)
+    std::vector<signatureLayer>                             inheritedMethodSignatures;       // Method signatures of all parent classes (one layer per parent class)                                           
+    variableMap                                             attributes;                      // Key is attribute name and value is attribute object. Inherited attributes are in inheritedAttributes
+    std::shared_ptr<variableMap>                            nonPrivateAttributes{std::make_shared<variableMap>()}; // Non-private attributes of class (shared with child classes)
+    std::vector<attributeLayer>                             inheritedAttributes;             // Attributes inherited from all parent classes (one layer per parent class)
+    std::vector<attributeLayer>                             nonPrivateInheritedAttributes;   // Inherited attributes that are passed on to child classes
     std::unordered_map<int, std::vector<std::string>>       xpath;                           // Unique xpath for class (classes if partial in C#) along with the unit number
     bool                                                    inherited{false};                // Did class inherit the attributes yet? (Used for inheritance)
     bool                                                    visited{false};                  // Has class been visited yet when inheriting? (Used for inheritance)    
     int                                                     constructorDestructorCount{0};   // Number of constructor + destructor methods (Needed for class stereotypes)
+    std::vector
+    <std::pair<std::string, stereotypeSet>>                 externalMethodStereotypes;       // Unit file name and stereotypes of methods that are not in the input archive (From project index). Constructors and destructors are not included
+    std::vector<std::int64_t>                               spilledMethods;                  // Offsets of the methods written to the spill file (--max-memory). Methods in memory come after them
+    std::size_t                                             loadedMethods{0};                // Number of methods in memory that were read back from the spill file
 }; 
 
 #endif
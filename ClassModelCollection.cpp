@@ -17,111 +17,116 @@ extern primitiveTypes                PRIMITIVES;
 extern ignorableCalls                IGNORED_CALLS;
 extern typeModifiers                 TYPE_MODIFIERS;  
 extern bool                          IS_VERBOSE;
+extern projectIndex                  PROJECT_INDEX;
+extern summaryPacks                  SUMMARY_PACKS;
+extern std::string                   CHECKPOINT_DIRECTORY;
+extern int                           CHECKPOINT_INTERVAL;
+extern bool                          RESUME;
+extern int                           STOP_AFTER_CHECKPOINT;
+extern std::size_t                   MAX_MEMORY;
+
+static const int                     TXT_REPORT_WIDTH    = 70;
+static const std::string             TXT_REPORT_LINE(TXT_REPORT_WIDTH * 2, '-');
+
+static void outputTxtFreeFunctionHeader(std::ostream& out) {
+    out << std::left << std::setw(TXT_REPORT_WIDTH) << "Free Function Name:" << std::setw(TXT_REPORT_WIDTH) << "Free Function Stereotype:" << '\n';
+}
 
-classModelCollection::classModelCollection (srcml_archive* archive, srcml_archive* outputArchive,
-                                            const std::string& inputFile, const std::string& outputFile, 
-                                            bool outputTxtReport, bool outputCsvReport, bool reDocComment) {  
-    PRIMITIVES.createPrimitiveList();
-    IGNORED_CALLS.createCallList();
-    TYPE_MODIFIERS.createModifierList();
-
-    if (IS_VERBOSE) {
-        PRIMITIVES.outputPrimitives();
-        IGNORED_CALLS.outputCalls();
-        TYPE_MODIFIERS.outputModifiers();
-    }
-        
-    // Read all units in an archive
-    srcml_unit* unit = srcml_archive_read_unit(archive);
-    int unitNumber = 1; // Count starts at 1 in XPath
-    while (unit){
-        // Collects class info + methods defined internally to a class
-        findClassInfo(archive, unit, unitNumber); 
-        findFreeFunctions(archive, unit, unitNumber);
-
-        srcml_unit_free(unit); 
-        ++unitNumber;
-        unit = srcml_archive_read_unit(archive);
-    }   
-    analyzeFreeFunctions();
-
-    // Finds inherited attributes for each class
-    for (auto& pair : classCollection) {
-        findInheritedAttributes(pair.second);
-        pair.second.setInherited(true);
-        for (auto& pairS : classCollection)
-            pairS.second.setVisited(false);
-    } 
-
-    // Resets inheritance and build signatures for findInheritedMethod()
-    for (auto& pair : classCollection) {
-        pair.second.setInherited(false); 
-        pair.second.buildMethodSignature();
+// FNV-1a hash of the contents of a file
+// Used to check that a checkpoint is for the same input archive
+//
+static std::int64_t hashFile(const std::string& fileName) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    std::ifstream in(fileName, std::ios::binary);
+    std::vector<char> buffer(1 << 20);
+    while (in) {
+        in.read(buffer.data(), buffer.size());
+        std::streamsize size = in.gcount();
+        for (std::streamsize i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ULL;
+        }
     }
-        
-    // Finds inherited methods
-    for (auto& pair : classCollection) {
-        findInheritedMethods(pair.second);
-        pair.second.setInherited(true);
-        for (auto& pairS : classCollection)
-            pairS.second.setVisited(false);
-    } 
+    return static_cast<std::int64_t>(hash);
+}
 
-    // Analyze all methods for each class
-    for (auto& pair : classCollection) {
-        std::vector<methodModel>& methods = pair.second.getMethods();
-    
-        for (auto& m : methods)
-             m.findMethodData(pair.second.getAttribute(), pair.second.getMethodSignatures(), 
-                              pair.second.getInheritedMethodSignatures(), pair.second.getName()[3]);                         
+// Stops the run once STOP_AFTER_CHECKPOINT checkpoints are written (same as an interrupted run)
+//
+static void stopAfterCheckpoint() {
+    static int written = 0;
+    if (STOP_AFTER_CHECKPOINT > 0 && ++written == STOP_AFTER_CHECKPOINT) {
+        std::cerr << "Stopped after checkpoint " << written << '\n';
+        std::exit(-1);
     }
+}
 
-    // Compute method and stereotypes here
-    for (auto& pair : classCollection) {
-        pair.second.computeMethodStereotype();
-        pair.second.computeClassStereotype();
+classModelCollection::classModelCollection (srcml_archive* archive, srcml_archive* outputArchive,
+                                            const std::string& inputFile, const std::string& outputFile, 
+                                            bool outputTxtReport, bool outputCsvReport, bool reDocComment,
+                                            const std::string& indexFile, const std::string& summaryFile) {  
+    bool checkpoint = CHECKPOINT_DIRECTORY != "";
+    std::string phase = "ingestion";
+    int unitNumber = 1; // Count starts at 1 in XPath
+    if (checkpoint) inputHash = hashFile(inputFile);
+    if (checkpoint && RESUME) readCheckpoint(inputFile, phase, unitNumber);
+    else if (checkpoint) {
+        std::error_code error;
+        std::filesystem::remove_all(CHECKPOINT_DIRECTORY, error);
     }
+    if (MAX_MEMORY > 0) openSpillFile(outputFile);
 
-    for (auto& f : freeFunctions) 
-        f.findFreeFunctionData();
-    
-    computeFreeFunctionsStereotypes();
+    srcml_unit* unit = nullptr;
+    if (phase == "ingestion") {
+        // Units already collected in the checkpoint are skipped
+        for (int i = 1; i < unitNumber; ++i) {
+            unit = srcml_archive_read_unit(archive);
+            if (unit) srcml_unit_free(unit);
+        }
 
-    // Optional TXT report file
-    std::string InputFileNoExt = inputFile.substr(0, inputFile.size() - 4);
-    if (outputTxtReport) {
-        std::ofstream reportFile(InputFileNoExt + ".stereotypes.txt");
-        std::stringstream stringStream;
-        for (auto& pair : classCollection) 
-            outputTxtReportFile(stringStream, &pair.second);
-        reportFile << stringStream.str();
-        reportFile.close();         
+        // Read all units in an archive
+        unit = srcml_archive_read_unit(archive);
+        while (unit){
+            const char* filename = srcml_unit_get_filename(unit);
+            unitFilenames[unitNumber] = filename ? filename : "";
+            inputFilenames.insert(unitFilenames[unitNumber]);
+
+            // Collects class info + methods defined internally to a class
+            findClassInfo(archive, unit, unitNumber); 
+            findFreeFunctions(archive, unit, unitNumber);
+            limitMemory(true, true);
+
+            srcml_unit_free(unit); 
+            ++unitNumber;
+            unit = srcml_archive_read_unit(archive);
 
-        reportFile.open(InputFileNoExt + ".free_functions_stereotypes.txt");
-        std::stringstream stringStreamFunctions;  // Declare a new stringstream
-        outputTxtReportFile(stringStreamFunctions, nullptr);
-        reportFile << stringStreamFunctions.str();
-        reportFile.close();   
-    }
+            if (checkpoint && unit && (unitNumber - 1) % CHECKPOINT_INTERVAL == 0)
+                writeCheckpoint(inputFile, "ingestion", unitNumber);
+        }   
 
-    // Optional CSV report file
-    if (outputCsvReport) {
-        std::ofstream out;
-        out.open(InputFileNoExt + ".stereotypes.csv");
-        out << "Class Name,Class Stereotype,Method Name,Method Stereotype" << '\n';
-        for (auto& pair : classCollection)
-            outputCsvReportFile(out, &pair.second);        
-        out.close();
+        // Adds the parts of the classes that are defined in units that are not in the input archive
+        if (!PROJECT_INDEX.empty()) {
+            for (auto& pair : classCollection) {
+                const classModel* indexed = PROJECT_INDEX.findIndexedClass(pair.first);
+                if (indexed) pair.second.mergeIndex(*indexed, inputFilenames);
+            }
+        }
 
-        out.open(InputFileNoExt + ".free_functions_stereotypes.csv");
-        out << "Free Function Name,Free Function Stereotype" << '\n';
+        analyzeSpilledFreeFunctions();
+        analyzeClasses(nullptr);
+        findFreeFunctionsData(freeFunctions);
 
-        outputCsvReportFile(out, nullptr);        
-        out.close();
+        if (checkpoint) writeCheckpoint(inputFile, "analysis", 0);
     }
+    
+    computeStereotypes();
 
-    if (IS_VERBOSE) 
-        outputCsvVerboseReportFile(InputFileNoExt);
+    if (indexFile != "") outputIndex(indexFile, PROJECT_INDEX_KIND);
+    if (summaryFile != "") outputIndex(summaryFile, MODULE_SUMMARY_KIND);
+
+    // Optional TXT and CSV report files
+    std::string InputFileNoExt = inputFile.substr(0, inputFile.size() - 4);
+    outputReports(InputFileNoExt, outputTxtReport, outputCsvReport);
+    closeSpillFile();
     
     // Generate the stereotyped XML archive
     std::map<int, srcml_unit*> transformedUnits;
@@ -135,12 +140,25 @@ classModelCollection::classModelCollection (srcml_archive* archive, srcml_archiv
     unsigned int threadPoolCount = 0;
     unsigned int nthreads = std::thread::hardware_concurrency();
 
+    // With checkpoints, the output is written to segments that are merged at the end
+    int segments = 0;
+    srcml_archive* segmentArchive = nullptr;
+    unsigned int segmentStart = 1;
+    if (checkpoint && phase == "analysis") readOutputCheckpoint(unitNumberCount, segments);
+    segmentStart = unitNumberCount;
+
     // Read all units in the archive again for output generation
     srcml_archive_close(archive);
     srcml_archive_free(archive);
 
     archive = srcml_archive_create();
     srcml_archive_read_open_filename(archive, inputFile.c_str()); 
+
+    // Units already written in the output segments are skipped
+    for (unsigned int i = 1; i < unitNumberCount; ++i) {
+        unit = srcml_archive_read_unit(archive);
+        if (unit) srcml_unit_free(unit);
+    }
     unit = srcml_archive_read_unit(archive);
 
     while (unit){
@@ -160,9 +178,12 @@ classModelCollection::classModelCollection (srcml_archive* archive, srcml_archiv
             if (thread.joinable()) thread.join();
         threads.clear();
 
+        if (checkpoint && !segmentArchive) 
+            segmentArchive = openSegment(outputArchive, segments);
+
         // Write output
         for (const auto& pair : transformedUnits) 
-            srcml_archive_write_unit(outputArchive, pair.second); 
+            srcml_archive_write_unit(checkpoint ? segmentArchive : outputArchive, pair.second); 
         transformedUnits.clear();
 
         // Clean
@@ -174,39 +195,789 @@ classModelCollection::classModelCollection (srcml_archive* archive, srcml_archiv
         units.clear();
 
         threadPoolCount = 0;       
+
+        if (checkpoint && (unitNumberCount - segmentStart >= static_cast<unsigned int>(CHECKPOINT_INTERVAL) || !unit)) {
+            srcml_archive_close(segmentArchive);
+            srcml_archive_free(segmentArchive);
+            segmentArchive = nullptr;
+            ++segments;
+            segmentStart = unitNumberCount;
+            writeOutputCheckpoint(unitNumberCount, segments);
+        }
     }
 
+    if (checkpoint) mergeSegments(outputArchive, segments);
+
     srcml_archive_close(outputArchive);
     srcml_archive_free(outputArchive);   
     srcml_archive_close(archive);
     srcml_archive_free(archive);
 
+    // The run is complete
+    if (checkpoint) {
+        std::error_code error;
+        std::filesystem::remove_all(CHECKPOINT_DIRECTORY, error);
+    }
+
     // Annotate as comments
-    if (reDocComment){
-        std::string temp = outputFile + ".temp.xml";
+    if (reDocComment)
+        outputCommentArchive(outputFile);
+}
 
-        archive = srcml_archive_create();
-        srcml_archive_read_open_filename(archive, outputFile.c_str());  
+// Checkpoints
+// checkpoint.bin holds the input archive (path, size, modification time, and content hash), followed by records
+// Each record holds the phase, the next unit to collect, and classes and free functions:
+//  - Every CHECKPOINT_INTERVAL units while collecting, a record with the classes collected since the last record 
+//     (which replace their earlier versions), the new free functions, and the file names of the new units is appended
+//  - After the analysis, the file is replaced by one record with all classes and free functions
+// Each record ends with the magic string, so a record that was cut short is ignored
+// output.bin holds the next unit to output and the number of output segments written so far
+// New files are written to a temporary file first, so the last checkpoint is always consistent
+//
+void classModelCollection::writeCheckpoint(const std::string& inputFile, const std::string& phase, int nextUnit) {
+    std::error_code error;
+    std::filesystem::create_directories(CHECKPOINT_DIRECTORY, error);
+    std::filesystem::path file = std::filesystem::path(CHECKPOINT_DIRECTORY) / "checkpoint.bin";
+    std::filesystem::path temp = std::filesystem::path(CHECKPOINT_DIRECTORY) / "checkpoint.bin.temp";
+
+    bool append = checkpointUnit > 0 && phase == "ingestion";
+    std::ofstream out(append ? file : temp, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if (!out) {
+        std::cerr << "Error: Unable to write checkpoint: " << file.string() << '\n';
+        return;
+    }
 
-        outputArchive = srcml_archive_create();
-        srcml_archive_write_open_filename(outputArchive, temp.c_str());
-        srcml_archive_register_namespace(outputArchive, "st", "http://www.srcML.org/srcML/stereotype"); 
+    if (!append) {
+        out.write(CHECKPOINT_MAGIC.data(), CHECKPOINT_MAGIC.size());
+        writeInteger(out, CHECKPOINT_VERSION);
+        writeString(out, std::filesystem::absolute(inputFile, error).string());
+        writeInteger(out, std::filesystem::file_size(inputFile, error));
+        writeInteger(out, std::filesystem::last_write_time(inputFile, error).time_since_epoch().count());
+        writeInteger(out, inputHash);
+    }
+    writeString(out, phase);
+    writeInteger(out, nextUnit);
+
+    std::vector<const classModel*> classes;
+    if (append) {
+        for (const std::string& className : checkpointClasses) {
+            auto result = classCollection.find(className);
+            if (result != classCollection.end()) classes.push_back(&result->second);
+        }
+    }
+    else {
+        for (const auto& pair : classCollection) 
+            classes.push_back(&pair.second);
+    }
+    writeInteger(out, classes.size());
+    for (const classModel* c : classes) 
+        c->writeCheckpoint(out);
+
+    flatStringMap<std::string> generics;
+    if (append) {
+        for (const classModel* c : classes) {
+            auto result = classGenerics.find(c->getName()[2]);
+            if (result != classGenerics.end()) generics.insert(*result);
+        }
+    }
+    writeStringMap(out, append ? generics : classGenerics);
+
+    std::size_t firstFunction = append ? checkpointFunctions : 0;
+    writeInteger(out, freeFunctions.size() - firstFunction);
+    for (std::size_t i = firstFunction; i < freeFunctions.size(); ++i) 
+        freeFunctions[i].writeCheckpoint(out);
+
+    std::vector<std::pair<int, std::string>> filenames;
+    for (const auto& pair : unitFilenames)
+        if (!append || pair.first >= checkpointUnit) filenames.push_back(pair);
+    writeInteger(out, filenames.size());
+    for (const auto& pair : filenames) {
+        writeInteger(out, pair.first);
+        writeString(out, pair.second);
+    }
+    writeString(out, CHECKPOINT_MAGIC);
+    out.close();
 
-        unit = srcml_archive_read_unit(archive);
+    if (!out) {
+        std::cerr << "Error: Unable to write checkpoint: " << file.string() << '\n';
+        return;
+    }
+    if (!append) std::filesystem::rename(temp, file, error);
 
-        // Read all units in an archive
+    checkpointUnit = nextUnit;
+    checkpointFunctions = freeFunctions.size();
+    checkpointClasses.clear();
+    stopAfterCheckpoint();
+}
+
+// Reads the last checkpoint
+// If there is no checkpoint for the input archive, phase and nextUnit are not changed (the run starts over)
+// Records are applied in order up to the first one that was cut short, which is removed from the file
+//
+void classModelCollection::readCheckpoint(const std::string& inputFile, std::string& phase, int& nextUnit) {
+    std::filesystem::path file = std::filesystem::path(CHECKPOINT_DIRECTORY) / "checkpoint.bin";
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) return;
+
+    std::error_code error;
+    std::string magic(CHECKPOINT_MAGIC.size(), '\0');
+    in.read(&magic[0], magic.size());
+    if (!in || magic != CHECKPOINT_MAGIC || readInteger(in) != CHECKPOINT_VERSION ||
+        readString(in) != std::filesystem::absolute(inputFile, error).string() ||
+        readInteger(in) != static_cast<std::int64_t>(std::filesystem::file_size(inputFile, error)) ||
+        readInteger(in) != static_cast<std::int64_t>(std::filesystem::last_write_time(inputFile, error).time_since_epoch().count()) ||
+        readInteger(in) != inputHash) {
+        std::cerr << "Warning: Checkpoint is not for " << inputFile << ", starting over" << '\n';
+        return;
+    }
+
+    flatStringMap<classModel> classes;
+    flatStringMap<std::string> generics;
+    std::vector<methodModel> functions;
+    std::unordered_map<int, std::string> filenames;
+    std::string checkpointPhase;
+    int checkpointNextUnit = 0;
+    std::streamoff recordsEnd = 0;
+    while (in) {
+        std::string recordPhase = readString(in);
+        int recordNextUnit = readInteger(in);
+
+        std::vector<classModel> recordClasses;
+        std::int64_t count = readInteger(in);
+        for (std::int64_t i = 0; in && i < count; ++i) {
+            recordClasses.emplace_back();
+            recordClasses.back().readCheckpoint(in);
+        }
+        flatStringMap<std::string> recordGenerics = readStringMap(in);
+        std::vector<methodModel> recordFunctions;
+        count = readInteger(in);
+        for (std::int64_t i = 0; in && i < count; ++i) {
+            recordFunctions.emplace_back();
+            recordFunctions.back().readCheckpoint(in);
+        }
+        std::vector<std::pair<int, std::string>> recordFilenames;
+        count = readInteger(in);
+        for (std::int64_t i = 0; in && i < count; ++i) {
+            int key = readInteger(in);
+            recordFilenames.push_back({key, readString(in)});
+        }
+        if (!in || readString(in) != CHECKPOINT_MAGIC) break;
+
+        for (classModel& c : recordClasses) {
+            std::string className = c.getName()[1];
+            auto result = classes.find(className);
+            if (result != classes.end()) result->second = std::move(c);
+            else classes.emplace(className, std::move(c));
+        }
+        for (const auto& pair : recordGenerics) 
+            generics.insert(pair);
+        for (methodModel& f : recordFunctions) 
+            functions.push_back(std::move(f));
+        for (const auto& pair : recordFilenames) 
+            filenames.insert(pair);
+        checkpointPhase = recordPhase;
+        checkpointNextUnit = recordNextUnit;
+        recordsEnd = in.tellg();
+    }
+    in.close();
+
+    if (recordsEnd == 0) {
+        std::cerr << "Warning: Checkpoint is invalid, starting over" << '\n';
+        return;
+    }
+    // New records are appended after the last complete one
+    std::filesystem::resize_file(file, recordsEnd, error);
+
+    classCollection = std::move(classes);
+    classGenerics = std::move(generics);
+    freeFunctions = std::move(functions);
+    unitFilenames = std::move(filenames);
+    inputFilenames.clear();
+    for (const auto& pair : unitFilenames) 
+        inputFilenames.insert(pair.second);
+    checkpointUnit = checkpointNextUnit;
+    checkpointFunctions = freeFunctions.size();
+    checkpointClasses.clear();
+    phase = checkpointPhase;
+    nextUnit = checkpointNextUnit;
+    std::cerr << "Resuming from checkpoint (" << phase << ")" << '\n';
+}
+
+void classModelCollection::writeOutputCheckpoint(unsigned int nextUnit, int segments) {
+    std::error_code error;
+    std::filesystem::path file = std::filesystem::path(CHECKPOINT_DIRECTORY) / "output.bin";
+    std::filesystem::path temp = std::filesystem::path(CHECKPOINT_DIRECTORY) / "output.bin.temp";
+
+    std::ofstream out(temp, std::ios::binary);
+    out.write(CHECKPOINT_MAGIC.data(), CHECKPOINT_MAGIC.size());
+    writeInteger(out, CHECKPOINT_VERSION);
+    writeInteger(out, nextUnit);
+    writeInteger(out, segments);
+    out.close();
+
+    if (out) std::filesystem::rename(temp, file, error);
+    stopAfterCheckpoint();
+}
+
+void classModelCollection::readOutputCheckpoint(unsigned int& nextUnit, int& segments) {
+    std::filesystem::path file = std::filesystem::path(CHECKPOINT_DIRECTORY) / "output.bin";
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) return;
+
+    std::string magic(CHECKPOINT_MAGIC.size(), '\0');
+    in.read(&magic[0], magic.size());
+    if (!in || magic != CHECKPOINT_MAGIC || readInteger(in) != CHECKPOINT_VERSION) return;
+
+    std::int64_t checkpointUnit = readInteger(in);
+    std::int64_t checkpointSegments = readInteger(in);
+    if (!in) return;
+
+    nextUnit = checkpointUnit;
+    segments = checkpointSegments;
+}
+
+// Opens the next output segment with the same namespaces as the output archive
+//
+srcml_archive* classModelCollection::openSegment(srcml_archive* outputArchive, int segment) {
+    std::string segmentFile = (std::filesystem::path(CHECKPOINT_DIRECTORY) / ("segment-" + std::to_string(segment) + ".xml")).string();
+    srcml_archive* segmentArchive = srcml_archive_create();
+    std::size_t size = srcml_archive_get_namespace_size(outputArchive);
+    for (std::size_t i = 0; i < size; i++) 
+        srcml_archive_register_namespace(segmentArchive, srcml_archive_get_namespace_prefix(outputArchive, i), 
+                                         srcml_archive_get_namespace_uri(outputArchive, i));
+    srcml_archive_write_open_filename(segmentArchive, segmentFile.c_str());
+    return segmentArchive;
+}
+
+// Writes the units of all output segments to the output archive
+//
+void classModelCollection::mergeSegments(srcml_archive* outputArchive, int segments) {
+    for (int i = 0; i < segments; ++i) {
+        std::string segmentFile = (std::filesystem::path(CHECKPOINT_DIRECTORY) / ("segment-" + std::to_string(i) + ".xml")).string();
+        srcml_archive* segmentArchive = srcml_archive_create();
+        if (srcml_archive_read_open_filename(segmentArchive, segmentFile.c_str())) {
+            std::cerr << "Error: Output segment not found: " << segmentFile << '\n';
+            srcml_archive_free(segmentArchive);
+            continue;
+        }
+
+        srcml_unit* unit = srcml_archive_read_unit(segmentArchive);
         while (unit) {
-            outputAsComments(unit, outputArchive);
+            srcml_archive_write_unit(outputArchive, unit);
             srcml_unit_free(unit);
-            unit = srcml_archive_read_unit(archive);
+            unit = srcml_archive_read_unit(segmentArchive);
+        }
+        srcml_archive_close(segmentArchive);
+        srcml_archive_free(segmentArchive);
+    }
+}
+
+// Streaming mode
+// Only the class index and the units in flight are kept in memory:
+//  1. The class index of the archive is built (see indexArchive())
+//  2. Units are read again and collected into their group. When the last unit of a group is read,
+//      the group is analyzed, its report lines are written, and it is freed
+//  3. A second reader of the archive writes each unit as soon as all units before it are computed
+// Stereotypes are the same as without streaming, since the units of a class are always in the same group
+//
+void classModelCollection::streamStereotypes(srcml_archive* archive, srcml_archive* outputArchive,
+                                             const std::string& inputFile, const std::string& outputFile, 
+                                             bool outputTxtReport, bool outputCsvReport, bool reDocComment,
+                                             const std::string& summaryFile) {
+    int units = indexArchive(archive);
+    if (summaryFile != "") outputIndex(summaryFile, MODULE_SUMMARY_KIND);
+
+    // Symbols interned after the index are names of the groups in flight
+    std::size_t indexSymbols = SYMBOLS.size();
+    std::size_t peakSymbols = indexSymbols;
+    std::size_t peakTypeCache = 0;
+
+    srcml_archive_close(archive);
+    srcml_archive_free(archive);
+
+    // Optional TXT and CSV report files are written one group at a time
+    std::string InputFileNoExt = inputFile.substr(0, inputFile.size() - 4);
+    std::ofstream txtReport, txtFunctionReport, csvReport, csvFunctionReport;
+    if (outputTxtReport) {
+        txtReport.open(InputFileNoExt + ".stereotypes.txt");
+        txtFunctionReport.open(InputFileNoExt + ".free_functions_stereotypes.txt");
+        outputTxtFreeFunctionHeader(txtFunctionReport);
+    }
+    if (outputCsvReport) {
+        csvReport.open(InputFileNoExt + ".stereotypes.csv");
+        csvReport << "Class Name,Class Stereotype,Method Name,Method Stereotype" << '\n';
+        csvFunctionReport.open(InputFileNoExt + ".free_functions_stereotypes.csv");
+        csvFunctionReport << "Free Function Name,Free Function Stereotype" << '\n';
+    }
+    stereotypeCounts counts;
+
+    srcml_archive* groupArchive = srcml_archive_create();
+    srcml_archive_read_open_filename(groupArchive, inputFile.c_str()); 
+    archive = srcml_archive_create();
+    srcml_archive_read_open_filename(archive, inputFile.c_str()); 
+
+    std::map<int, classModelCollection> groups; // Groups in flight. Key is the first unit of the group
+    unsigned int nextOutput = 1;
+    srcml_unit* unit = srcml_archive_read_unit(groupArchive);
+    for (int unitNumber = 1; unit && unitNumber <= units; ++unitNumber) {
+        int first = unitGroups[unitNumber];
+        classModelCollection& group = groups[first];
+        const char* filename = srcml_unit_get_filename(unit);
+        group.unitFilenames[unitNumber] = filename ? filename : "";
+
+        group.findClassInfo(groupArchive, unit, unitNumber); 
+        group.findFreeFunctions(groupArchive, unit, unitNumber);
+
+        srcml_unit_free(unit); 
+        unit = srcml_archive_read_unit(groupArchive);
+        if (groupLastUnit[first] != unitNumber) continue;
+
+        group.analyzeGroup(*this);
+        if (outputTxtReport) {
+            for (auto& pair : group.classCollection) 
+                group.outputTxtReportFile(txtReport, &pair.second);
+            group.outputTxtReportFile(txtFunctionReport, nullptr, false);
+        }
+        if (outputCsvReport) {
+            for (auto& pair : group.classCollection)
+                group.outputCsvReportFile(csvReport, &pair.second);
+            group.outputCsvReportFile(csvFunctionReport, nullptr);
+        }
+        if (IS_VERBOSE) group.countStereotypes(counts);
+        groups.erase(first);
+
+        // Names and type classifications of finished groups are dropped, so they don't grow with the archive
+        // Symbols can only be dropped when no group is in flight, since symbols are shared between groups
+        peakSymbols = std::max(peakSymbols, SYMBOLS.size());
+        peakTypeCache = std::max(peakTypeCache, typeCacheSize());
+        clearTypeCache();
+        if (groups.empty()) SYMBOLS.truncate(indexSymbols);
+
+        // Units before the first unit of the groups in flight are computed
+        unsigned int lastOutput = groups.empty() ? unitNumber : groups.begin()->first - 1;
+        outputStreamUnits(archive, outputArchive, nextOutput, lastOutput);
+    }
+    if (unit) srcml_unit_free(unit);
+
+    if (outputTxtReport) txtFunctionReport << TXT_REPORT_LINE << '\n';
+    txtReport.close();
+    txtFunctionReport.close();
+    csvReport.close();
+    csvFunctionReport.close();
+    if (IS_VERBOSE) {
+        outputCsvVerboseReportFile(InputFileNoExt, counts);
+        std::cout << "Symbols: " << indexSymbols << " after indexing, " << peakSymbols << " at most, " 
+                  << SYMBOLS.size() << " after streaming" << '\n';
+        std::cout << "Type cache: " << peakTypeCache << " entries at most per group, " 
+                  << typeCacheSize() << " after streaming" << '\n';
+    }
+
+    srcml_archive_close(outputArchive);
+    srcml_archive_free(outputArchive);   
+    srcml_archive_close(groupArchive);
+    srcml_archive_free(groupArchive);
+    srcml_archive_close(archive);
+    srcml_archive_free(archive);
+
+    // Annotate as comments
+    if (reDocComment)
+        outputCommentArchive(outputFile);
+}
+
+// Streaming mode
+// Builds the class index of the archive: names, parents, non-private attributes, and method signatures
+//  of all classes after inheritance. Methods are dropped once their signatures are built
+// Units that share a class (e.g., parts of a partial class in C#, or a C++ class and its methods
+//  defined externally) are joined into one group, so a class is analyzed with all of its methods
+// Returns the number of units
+//
+int classModelCollection::indexArchive(srcml_archive* archive) {
+    struct externalMethod {
+        int                       unitNumber;
+        symbol                    signature;
+        std::vector<std::string>  classNames;
+    };
+    std::unordered_map<std::string, std::vector<int>>   classUnits;         // Units of each class
+    std::vector<externalMethod>                         externalMethods;    // Possible methods defined externally (C++)
+
+    int unitNumber = 1; // Count starts at 1 in XPath
+    unitGroups.assign(1, 0);
+    srcml_unit* unit = srcml_archive_read_unit(archive);
+    while (unit) {
+        const char* filename = srcml_unit_get_filename(unit);
+        inputFilenames.insert(filename ? filename : "");
+        unitGroups.push_back(unitNumber);
+
+        // Names of private attributes are only needed while the unit is indexed
+        std::pmr::monotonic_buffer_resource arena;
+        localSymbolTable unitSymbols(&arena);
+        classModelCollection unitFacts;
+        unitFacts.findClassInfo(archive, unit, unitNumber); 
+        unitFacts.findFreeFunctions(archive, unit, unitNumber);
+        srcml_unit_free(unit); 
+
+        for (auto& pair : unitFacts.classCollection) {
+            pair.second.reduceToIndex();
+            classUnits[pair.first].push_back(unitNumber);
+            auto result = classCollection.find(pair.first);
+            if (result != classCollection.end()) result->second.appendPartialClass(pair.second);
+            else classCollection.emplace(pair.first, std::move(pair.second));
+        }
+        classGenerics.insert(unitFacts.classGenerics.begin(), unitFacts.classGenerics.end());
+        for (const auto& f : unitFacts.freeFunctions) {
+            std::vector<std::string> classNames = findFreeFunctionClassNames(f);
+            if (!classNames.empty()) 
+                externalMethods.push_back({unitNumber, f.getNameSignatureSymbol(), std::move(classNames)});
+        }
+
+        ++unitNumber;
+        unit = srcml_archive_read_unit(archive);
+    }
+
+    // The first unit of a group represents the group
+    auto findGroup = [this](int u) {
+        while (unitGroups[u] != u) u = unitGroups[u] = unitGroups[unitGroups[u]];
+        return u;
+    };
+    auto joinGroups = [&](int a, int b) {
+        a = findGroup(a);
+        b = findGroup(b);
+        if (a < b) unitGroups[b] = a;
+        else unitGroups[a] = b;
+    };
+    for (const auto& pair : classUnits)
+        for (int u : pair.second) joinGroups(pair.second.front(), u);
+
+    // Methods defined externally are added to the signatures of their class and joined to its group
+    // Methods of a class that is only in the project index are joined together
+    std::unordered_map<std::string, int> indexedClassUnits;
+    for (const auto& m : externalMethods) {
+        bool found = false;
+        for (const std::string& className : m.classNames) {
+            auto result = classCollection.find(className);
+            if (result == classCollection.end()) continue;
+            result->second.addMethodSignature(m.signature);
+            joinGroups(m.unitNumber, classUnits[className].front());
+            found = true;
+            break;
+        }
+        for (const std::string& className : m.classNames) {
+            if (found || !PROJECT_INDEX.findIndexedClass(className)) continue;
+            joinGroups(m.unitNumber, indexedClassUnits.insert({className, m.unitNumber}).first->second);
+            break;
+        }
+    }
+
+    groupLastUnit.assign(unitNumber, 0);
+    for (int u = 1; u < unitNumber; ++u) {
+        unitGroups[u] = findGroup(u);
+        groupLastUnit[unitGroups[u]] = u;
+    }
+
+    // Adds the parts of the classes that are defined in units that are not in the input archive
+    if (!PROJECT_INDEX.empty()) {
+        for (auto& pair : classCollection) {
+            const classModel* indexed = PROJECT_INDEX.findIndexedClass(pair.first);
+            if (indexed) pair.second.mergeIndex(*indexed, inputFilenames);
+        }
+    }
+    findInheritance(nullptr);
+
+    return unitNumber - 1;
+}
+
+// Streaming mode
+// Analyzes the units of a group and computes their stereotypes
+// Parent classes that are in other groups are taken from the class index of the archive
+//
+void classModelCollection::analyzeGroup(classModelCollection& index) {
+    archiveIndex = &index;
+    if (!PROJECT_INDEX.empty()) {
+        for (auto& pair : classCollection) {
+            const classModel* indexed = PROJECT_INDEX.findIndexedClass(pair.first);
+            if (indexed) pair.second.mergeIndex(*indexed, index.inputFilenames);
+        }
+    }
+
+    analyzeFreeFunctions(freeFunctions);
+    analyzeClasses(nullptr);
+    findFreeFunctionsData(freeFunctions);
+    computeStereotypes(false);
+}
+
+// Streaming mode
+// Writes the units of the archive up to lastUnit with their stereotypes, then frees their xpaths
+// Units are transformed in parallel as in the constructor
+//
+void classModelCollection::outputStreamUnits(srcml_archive* archive, srcml_archive* outputArchive, 
+                                             unsigned int& nextUnit, unsigned int lastUnit) {
+    std::map<int, srcml_unit*> transformedUnits;
+    std::unordered_map<int, srcml_transform_result*> results;
+
+    std::vector<std::thread> threads;
+    std::vector<srcml_unit*> units;
+    std::mutex mu;
+    unsigned int nthreads = std::max(1u, std::thread::hardware_concurrency());
+
+    while (nextUnit <= lastUnit) {
+        unsigned int firstUnit = nextUnit;
+        while (units.size() < nthreads && nextUnit <= lastUnit) {
+            srcml_unit* unit = srcml_archive_read_unit(archive);
+            if (!unit) {
+                nextUnit = lastUnit + 1;
+                break;
+            }
+            units.push_back(unit);
+            threads.push_back(std::thread(&classModelCollection::outputWithStereotypes, this, 
+                                        unit, std::ref(transformedUnits), nextUnit,  
+                                        std::ref(XPATH_LIST[nextUnit]), std::ref(results), std::ref(mu)));
+            ++nextUnit;
+        }
+
+        for (std::thread& thread : threads) 
+            if (thread.joinable()) thread.join();
+        threads.clear();
+
+        for (const auto& pair : transformedUnits) 
+            srcml_archive_write_unit(outputArchive, pair.second); 
+        transformedUnits.clear();
+
+        for (auto& pair : results)  
+            srcml_transform_free(pair.second);  
+        results.clear();
+
+        for (auto& u : units) srcml_unit_free(u); 
+        units.clear();
+
+        for (unsigned int n = firstUnit; n < nextUnit && n <= lastUnit; ++n)
+            XPATH_LIST.erase(n);
+    }
+}
+
+// Memory cap (--max-memory)
+// Methods that are written out of memory are kept in a spill file next to the output file
+//
+void classModelCollection::openSpillFile(const std::string& outputFile) {
+    spillFilename = outputFile + ".spill";
+    spillFile.open(spillFilename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!spillFile.is_open()) 
+        std::cerr << "Error: Unable to write spill file: " << spillFilename << '\n';
+}
+
+// The spill file is removed once the methods are no longer needed (the output only needs the xpaths)
+//
+void classModelCollection::closeSpillFile() {
+    if (!spillFile.is_open()) return;
+    spillFile.close();
+    std::error_code error;
+    std::filesystem::remove(spillFilename, error);
+}
+
+// Memory cap (--max-memory)
+// Once the estimated size of the methods in memory is over the cap, the methods are spilled
+//
+void classModelCollection::limitMemory(bool changed, bool collecting) {
+    if (spillFile.is_open() && residentSize > MAX_MEMORY) spillModels(changed, collecting);
+}
+
+// Writes the methods of all classes to the spill file and frees them. They are read back one class
+//  at a time by each phase that needs them
+// Free functions are only spilled while units are collected (collecting is true). After the methods
+//  defined externally are moved to their class, the remaining free functions are kept in memory
+// changed is false if the methods read back were not changed, so they are not written again
+//
+void classModelCollection::spillModels(bool changed, bool collecting) {
+    for (auto& pair : classCollection)
+        pair.second.spillMethods(spillFile, changed);
+    if (collecting && !freeFunctions.empty()) {
+        spilledFreeFunctions.push_back(writeSpilledMethods(spillFile, freeFunctions, 0));
+        freeFunctions = std::vector<methodModel>();
+    }
+    residentSize = 0;
+}
+
+// Writes the classes that were read back from the spill file again. Called after a phase that changes 
+//  the methods, so the phases after can free them without writing them
+//
+void classModelCollection::spillLoadedModels() {
+    if (!spillFile.is_open()) return;
+    for (auto& pair : classCollection)
+        if (pair.second.HasLoadedMethods()) pair.second.spillMethods(spillFile, true);
+}
+
+void classModelCollection::loadMethods(classModel& c) {
+    if (spillFile.is_open()) c.loadMethods(spillFile);
+}
+
+// Analyzes free functions to determine externally defined methods, including the free functions in the
+//  spill file (--max-memory). Spilled free functions are read back one chunk at a time and are kept 
+//  before the free functions in memory, so the order is the same as without the cap
+//
+void classModelCollection::analyzeSpilledFreeFunctions() {
+    std::vector<methodModel> functions;
+    for (std::int64_t offset : spilledFreeFunctions) {
+        std::vector<methodModel> chunk;
+        readSpilledMethods(spillFile, offset, chunk);
+
+        // Only the methods moved to their class can be spilled again
+        std::size_t size = 0;
+        for (const auto& f : chunk) size += f.getMemorySize();
+        analyzeFreeFunctions(chunk);
+        for (auto& f : chunk) {
+            size -= f.getMemorySize();
+            functions.push_back(std::move(f));
+        }
+        residentSize += size;
+        limitMemory(false, false);
+    }
+    spilledFreeFunctions.clear();
+
+    analyzeFreeFunctions(freeFunctions);
+    if (functions.empty()) return;
+    for (auto& f : freeFunctions) 
+        functions.push_back(std::move(f));
+    freeFunctions = std::move(functions);
+}
+
+// Finds inherited attributes and methods, then analyzes the methods of each class
+// If affected is not null, only the classes listed in it are analyzed (watch mode). 
+//  All other classes are expected to be analyzed already
+//
+void classModelCollection::analyzeClasses(const std::unordered_set<std::string>* affected) {
+    findInheritance(affected);
+
+    // Analyze all methods for each class
+    // Facts collected while analyzing a method are allocated from an arena that is released in bulk after each class
+    //  (a class can be split across units, so the arena is per class rather than per unit)
+    std::pmr::monotonic_buffer_resource arena;
+    for (auto& pair : classCollection) {
+        if (affected && affected->find(pair.first) == affected->end()) continue;
+        loadMethods(pair.second);
+        std::vector<methodModel>& methods = pair.second.getMethods();
+        {
+            // Method signatures of the class and its parents are only merged while the class is analyzed
+            symbolSet signatures(&arena);
+            pair.second.findMethodSignatures(signatures);
+
+            for (auto& m : methods)
+                 m.findMethodData(pair.second.getAttribute(), pair.second.getInheritedAttribute(), 
+                                  signatures, pair.second.getName()[3], &arena);
+        }
+        arena.release();
+        residentSize += pair.second.getMemorySize();
+        limitMemory(true, false);
+    }
+    spillLoadedModels();
+}
+
+// Finds inherited attributes and methods of each class (or only of the affected classes if not null)
+//
+void classModelCollection::findInheritance(const std::unordered_set<std::string>* affected) {
+    // Finds inherited attributes for each class
+    for (auto& pair : classCollection) {
+        if (affected && affected->find(pair.first) == affected->end()) continue;
+        findInheritedAttributes(pair.second);
+        pair.second.setInherited(true);
+        for (auto& pairS : classCollection)
+            pairS.second.setVisited(false);
+    } 
+
+    // Resets inheritance and build signatures for findInheritedMethod()
+    for (auto& pair : classCollection) {
+        if (affected && affected->find(pair.first) == affected->end()) continue;
+        pair.second.setInherited(false); 
+        pair.second.buildMethodSignature();
+    }
+        
+    // Finds inherited methods
+    for (auto& pair : classCollection) {
+        if (affected && affected->find(pair.first) == affected->end()) continue;
+        findInheritedMethods(pair.second);
+        pair.second.setInherited(true);
+        for (auto& pairS : classCollection)
+            pairS.second.setVisited(false);
+    } 
+}
+
+// Computes method and class stereotypes as well as free function stereotypes
+// Any previously computed stereotypes are cleared first
+// If clearXpaths is false, the xpaths of other units are kept (streaming mode, 
+//  where units are written after the collection of their group is computed)
+//
+void classModelCollection::computeStereotypes(bool clearXpaths) {
+    if (clearXpaths) XPATH_LIST.clear();
+
+    // Features of all methods are extracted into one table and the rules are applied to the whole table at once
+    methodFeatures features;
+    std::vector<classModel*> classes;
+    for (auto& pair : classCollection) {
+        loadMethods(pair.second);
+        pair.second.addMethodFeatures(features, classes.size());
+        classes.push_back(&pair.second);
+        residentSize += pair.second.getMemorySize();
+        limitMemory(false, false);
+    }
+    features.classifyMethods();
+
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        std::size_t first = features.findFirstRow(i);
+        loadMethods(*classes[i]);
+        classes[i]->resetStereotype();
+        classes[i]->computeMethodStereotype(features, first);
+        classes[i]->computeClassStereotype(features, first);
+        residentSize += classes[i]->getMemorySize();
+        limitMemory(true, false);
+    }
+    spillLoadedModels();
+
+    for (auto& f : freeFunctions)
+        f.clearStereotype();
+    computeFreeFunctionsStereotypes();
+}
+
+// Optional TXT and CSV report files
+//
+void classModelCollection::outputReports(const std::string& InputFileNoExt, bool outputTxtReport, bool outputCsvReport) {
+    if (outputTxtReport) {
+        std::ofstream reportFile(InputFileNoExt + ".stereotypes.txt");
+        std::stringstream stringStream;
+        for (auto& pair : classCollection) {
+            loadMethods(pair.second);
+            outputTxtReportFile(stringStream, &pair.second);
+            limitMemory(false, false);
         }
+        reportFile << stringStream.str();
+        reportFile.close();         
 
-        std::filesystem::remove(outputFile);
-        std::filesystem::rename(temp, outputFile);
+        reportFile.open(InputFileNoExt + ".free_functions_stereotypes.txt");
+        std::stringstream stringStreamFunctions;  // Declare a new stringstream
+        outputTxtReportFile(stringStreamFunctions, nullptr);
+        reportFile << stringStreamFunctions.str();
+        reportFile.close();   
+    }
 
-        srcml_archive_close(archive); 
-        srcml_archive_close(outputArchive);
-        srcml_archive_free(outputArchive);   
+    if (outputCsvReport) {
+        std::ofstream out;
+        out.open(InputFileNoExt + ".stereotypes.csv");
+        out << "Class Name,Class Stereotype,Method Name,Method Stereotype" << '\n';
+        for (auto& pair : classCollection) {
+            loadMethods(pair.second);
+            outputCsvReportFile(out, &pair.second);        
+            limitMemory(false, false);
+        }
+        out.close();
+
+        out.open(InputFileNoExt + ".free_functions_stereotypes.csv");
+        out << "Free Function Name,Free Function Stereotype" << '\n';
+
+        outputCsvReportFile(out, nullptr);        
+        out.close();
+    }
+
+    if (IS_VERBOSE) {
+        stereotypeCounts counts;
+        countStereotypes(counts);
+        outputCsvVerboseReportFile(InputFileNoExt, counts);
     }
 }
 
@@ -253,17 +1024,24 @@ void classModelCollection::findClassInfo(srcml_archive* archive, srcml_unit* uni
             std::string classXpath = "(" + XPATH_TRANSFORMATION.getXpath(unitLanguage, "class") + ")[" + std::to_string(i + 1) + "]";
             classModel c(classArchive, unitClass, unitLanguage); 
 
+            // Needed for inheritance in Java and C#
+            if (unitLanguage != "C++") classGenerics.insert({c.getName()[2], c.getName()[1]}); 
+
             // Needed for partial classes in C#
-            if (classCollection.find(c.getName()[1]) != classCollection.end())
+            std::string className = c.getName()[1];
+            if (CHECKPOINT_DIRECTORY != "") checkpointClasses.insert(className);
+            auto partial = classCollection.find(className);
+            if (partial != classCollection.end()) {
                 // Append the partial class data to the existing partial class
-                classCollection.at(c.getName()[1]).findClassData(classArchive, unitClass, classXpath, unitNumber);
+                std::size_t size = partial->second.getMemorySize();
+                partial->second.findClassData(classArchive, unitClass, classXpath, unitNumber);
+                residentSize += partial->second.getMemorySize() - size;
+            }
             else {
                 c.findClassData(classArchive, unitClass, classXpath, unitNumber);      
-                classCollection.insert({c.getName()[1], c});  
+                residentSize += c.getMemorySize();
+                classCollection.emplace(className, std::move(c));  
             }                 
-
-            // Needed for inheritance in Java and C#
-            if (unitLanguage != "C++") classGenerics.insert({c.getName()[2], c.getName()[1]}); 
             
             free(unparsed);
             srcml_unit_free(unitClass);
@@ -324,9 +1102,8 @@ void classModelCollection::findFreeFunctions(srcml_archive* archive, srcml_unit*
             srcml_unit* methodUnit = srcml_archive_read_unit(methodArchive);
 
             std::string functionXpath =  "(" + XPATH_TRANSFORMATION.getXpath(unitLanguage,"free_function") + ")[" + std::to_string(i + 1) + "]";
-            methodModel function(methodArchive, methodUnit, functionXpath, unitLanguage, "", unitNumber);
-
-            freeFunctions.push_back(function);
+            freeFunctions.emplace_back(methodArchive, methodUnit, functionXpath, unitLanguage, "", unitNumber);
+            residentSize += freeFunctions.back().getMemorySize();
 
             free(unparsed); 
             srcml_unit_free(methodUnit);
@@ -340,39 +1117,205 @@ void classModelCollection::findFreeFunctions(srcml_archive* archive, srcml_unit*
 }
 
 // Analyzes free functions to determine externally defined methods
+// Methods are moved to their class and the remaining free functions are compacted in one pass (order is kept)
+//
+void classModelCollection::analyzeFreeFunctions(std::vector<methodModel>& functions) {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        classModel* c = findFreeFunctionClass(functions[i]);
+        if (c) // Class found, it is a method
+            c->addMethod(std::move(functions[i]));
+        else {
+            if (kept != i) functions[kept] = std::move(functions[i]);
+            ++kept;
+        }
+    }
+    functions.erase(functions.begin() + kept, functions.end());
+}
+
+// Analyzes the free functions
+// Facts collected while analyzing a free function are allocated from an arena that is released in bulk after each unit
+//
+void classModelCollection::findFreeFunctionsData(std::vector<methodModel>& functions) {
+    std::pmr::monotonic_buffer_resource arena;
+    int unitNumber = -1;
+    for (auto& f : functions) {
+        if (f.getUnitNumber() != unitNumber) {
+            arena.release();
+            unitNumber = f.getUnitNumber();
+        }
+        f.findFreeFunctionData(&arena);
+    }
+}
+
+// Returns the possible names of the class that an externally defined method belongs to (C++ only)
+// The second name is used in case a specialized template method belongs to the generic template class
+// Returns an empty list if it is a free function
+//
+std::vector<std::string> classModelCollection::findFreeFunctionClassNames(const methodModel& function) const {
+    std::vector<std::string> classNames;
+    if (function.getUnitLanguage() == "C++") {
+        // Removes namespaces if any
+        std::string functionName = function.getName();  
+        removeNamespace(functionName, false, "C++");
+
+        // Get the class name (if any). Else, it is a free function
+        std::size_t isClassName = functionName.find("::");
+        if (isClassName != std::string::npos) {
+            std::string className = functionName.substr(0, isClassName); 
+            classNames.push_back(className);
+            classNames.push_back(className.substr(0, className.find("<")));
+        }
+    }
+    return classNames;
+}
+
+// Finds the class that an externally defined method belongs to
+// If the class is not in the input archive, it is added from the project index (if any)
+// Returns nullptr if it is a free function
+// classCollection is a flat (open-addressing) map, so the returned pointer is invalidated
+//  by any insert into it (including the one done here for indexed classes). Use it before the next insert
 //
-void classModelCollection::analyzeFreeFunctions() {
-    for (std::vector<methodModel>::iterator function = freeFunctions.begin(); function != freeFunctions.end();) {
-        if (function->getUnitLanguage() == "C++") {
-            // Removes namespaces if any
-            std::string functionName = function->getName();  
-            removeNamespace(functionName, false, "C++");
-
-            // Get the class name (if any). Else, it is a free function
-            std::size_t isClassName = functionName.find("::");
-            if (isClassName != std::string::npos) { // Class found, it is a method       
-                std::string className = functionName.substr(0, isClassName); 
-                auto result = classCollection.find(className);
-                if (result != classCollection.end()) {
-                    result->second.addMethod(*function);
-                    function = freeFunctions.erase(function);
-                }                          
-                else { // Case specialized template method belongs to the generic template class
-                    className = className.substr(0, className.find("<"));
-                    result = classCollection.find(className);
-                    if (result != classCollection.end())  {
-                        result->second.addMethod(*function);
-                        function = freeFunctions.erase(function);
-                    } 
-                    else ++function;                                                  
+classModel* classModelCollection::findFreeFunctionClass(const methodModel& function) {
+    std::vector<std::string> classNames = findFreeFunctionClassNames(function);
+    for (const std::string& className : classNames) {
+        auto result = classCollection.find(className);
+        if (result != classCollection.end())
+            return &result->second;
+    }
+
+    for (const std::string& className : classNames) {
+        const classModel* indexed = PROJECT_INDEX.findIndexedClass(className);
+        if (indexed) {
+            classModel c = indexed->clone();
+            c.removeExternalMethods(archiveIndex ? archiveIndex->inputFilenames : inputFilenames);
+            return &classCollection.emplace(className, std::move(c)).first->second;
+        }
+    }
+    return nullptr;
+}
+
+// Watch mode
+// Replaces the facts of the changed units and re-analyzes only the affected classes.
+// Affected classes are classes defined in the changed units, classes that own externally defined
+//  methods in the changed units, and all of their child classes.
+// unitFacts holds the facts (before any analysis) collected separately from each unit
+// Returns the number of affected classes
+//
+std::size_t classModelCollection::updateUnits(const std::map<int, classModelCollection>& unitFacts, 
+                                              const std::unordered_set<int>& changedUnits) {
+    std::unordered_set<std::string> affected;
+
+    // Classes in the current model that were collected from a changed unit
+    for (const auto& pair : classCollection) {
+        bool inChangedUnit = false;
+        for (const auto& unitXpath : pair.second.getXpath())
+            if (changedUnits.find(unitXpath.first) != changedUnits.end()) inChangedUnit = true;
+        for (const auto& m : pair.second.getMethods())
+            if (changedUnits.find(m.getUnitNumber()) != changedUnits.end()) inChangedUnit = true;
+        if (inChangedUnit) affected.insert(pair.first);
+    }
+
+    // Classes and owners of externally defined methods in the changed units
+    flatStringMap<std::string> generics;
+    for (const auto& unit : unitFacts) {
+        for (const auto& pair : unit.second.classGenerics)
+            generics.insert(pair);
+        if (changedUnits.find(unit.first) == changedUnits.end()) continue;
+
+        for (const auto& pair : unit.second.classCollection)
+            affected.insert(pair.first);
+        for (const auto& f : unit.second.freeFunctions)
+            for (const std::string& className : findFreeFunctionClassNames(f))
+                affected.insert(className);
+    }
+
+    // Child classes of affected classes, and all possible owners of externally 
+    //  defined methods that could belong to an affected class
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& unit : unitFacts) {
+            for (const auto& pair : unit.second.classCollection) {
+                if (affected.find(pair.first) != affected.end()) continue;
+                for (const auto& parent : pair.second.getParentClassName()) {
+                    std::string parClassName = parent.first;
+                    bool isAffected = affected.find(parClassName) != affected.end() ||
+                                      affected.find(parClassName.substr(0, parClassName.find("<"))) != affected.end();
+                    if (!isAffected && pair.second.getUnitLanguage() != "C++") {
+                        removeBetweenComma(parClassName, true);
+                        auto resultG = generics.find(parClassName);
+                        isAffected = resultG != generics.end() && affected.find(resultG->second) != affected.end();
+                    }
+                    if (isAffected) {
+                        affected.insert(pair.first);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            for (const auto& f : unit.second.freeFunctions) {
+                std::vector<std::string> classNames = findFreeFunctionClassNames(f);
+                bool isAffected = false;
+                for (const std::string& className : classNames)
+                    if (affected.find(className) != affected.end()) isAffected = true;
+                if (isAffected) {
+                    for (const std::string& className : classNames)
+                        if (affected.insert(className).second) changed = true;
                 }
             }
-            else ++function;
         }
-        else ++function;
     }
-}
 
+    // Remove the affected classes and free functions
+    for (const std::string& className : affected)
+        classCollection.erase(className);
+
+    for (auto it = classGenerics.begin(); it != classGenerics.end();) {
+        if (affected.find(it->second) != affected.end()) it = classGenerics.erase(it);
+        else ++it;
+    }
+
+    auto isFreeFunctionAffected = [&](const methodModel& f) {
+        if (changedUnits.find(f.getUnitNumber()) != changedUnits.end()) return true;
+        for (const std::string& className : findFreeFunctionClassNames(f))
+            if (affected.find(className) != affected.end()) return true;
+        return false;
+    };
+
+    freeFunctions.erase(std::remove_if(freeFunctions.begin(), freeFunctions.end(), isFreeFunctionAffected), freeFunctions.end());
+
+    // Add the affected classes and free functions back from the facts of each unit (in unit order)
+    std::vector<methodModel> functions;
+    for (const auto& unit : unitFacts) {
+        for (const auto& pair : unit.second.classCollection) {
+            if (affected.find(pair.first) == affected.end()) continue;
+
+            auto result = classCollection.find(pair.first);
+            if (result != classCollection.end())
+                result->second.appendPartialClass(pair.second); // Needed for partial classes in C#
+            else
+                classCollection.emplace(pair.first, pair.second.clone());
+        }
+        for (const auto& pair : unit.second.classGenerics)
+            if (affected.find(pair.second) != affected.end()) classGenerics.insert(pair);
+
+        for (const auto& f : unit.second.freeFunctions)
+            if (isFreeFunctionAffected(f)) functions.push_back(f.clone());
+    }
+
+    // Analyze the affected classes and free functions only
+    analyzeFreeFunctions(functions);
+    analyzeClasses(&affected);
+    findFreeFunctionsData(functions);
+
+    for (auto& f : functions)
+        freeFunctions.push_back(std::move(f));
+
+    computeStereotypes();
+
+    return affected.size();
+}
 
 // Finds inherited attributes 
 // In C++, you can inherit from a specialized templated class or
@@ -389,56 +1332,26 @@ void classModelCollection::analyzeFreeFunctions() {
 void classModelCollection::findInheritedAttributes(classModel& c) {   
     const std::string& unitLanguage = c.getUnitLanguage();
     c.setVisited(true); 
-    const std::unordered_map<std::string, std::string>& parentClassName =  c.getParentClassName();
+    const flatStringMap<std::string>& parentClassName =  c.getParentClassName();
 
     for (const auto& pair : parentClassName){
-        std::string parClassName = pair.first;
-        auto result = classCollection.find(parClassName);
-        if (result != classCollection.end()) {
-            if (result->second.HasInherited() && !result->second.IsVisited()) {
-                c.inheritAttribute(result->second.getNonPrivateAndInheritedAttribute(), pair.second); 
-                result->second.setVisited(true);
+        classModel* parent = findParentClass(pair.first, unitLanguage);
+        if (parent) {
+            if (parent->HasInherited() && !parent->IsVisited()) {
+                c.inheritAttribute(*parent, pair.second); 
+                parent->setVisited(true);
             }
                 
-            else if (!result->second.IsVisited()) {
-                findInheritedAttributes(result->second);                     
-                c.inheritAttribute(result->second.getNonPrivateAndInheritedAttribute(), pair.second);  
+            else if (!parent->IsVisited()) {
+                findInheritedAttributes(*parent);                     
+                c.inheritAttribute(*parent, pair.second);  
             }
-        }       
+        }
         else {
-            if (unitLanguage == "C++") {
-                parClassName = parClassName.substr(0, parClassName.find("<"));
-                result = classCollection.find(parClassName);
-                if (result != classCollection.end()) {
-                    if (result->second.HasInherited() && !result->second.IsVisited()) {
-                        c.inheritAttribute(result->second.getNonPrivateAndInheritedAttribute(), pair.second); 
-                        result->second.setVisited(true);
-                    }
-                        
-                    else if (!result->second.IsVisited()) {
-                        findInheritedAttributes(result->second);                     
-                        c.inheritAttribute(result->second.getNonPrivateAndInheritedAttribute(), pair.second);  
-                    }
-                }              
-            }
-            else {  
-                removeBetweenComma(parClassName, true);
-                auto resultG = classGenerics.find(parClassName);
-                if (resultG != classGenerics.end()) {
-                    auto resultM = classCollection.find(resultG->second);
-                    if (resultM != classCollection.end()) {
-                        if (resultM->second.HasInherited() && !resultM->second.IsVisited()) {
-                            c.inheritAttribute(resultM->second.getNonPrivateAndInheritedAttribute(), pair.second); 
-                            resultM->second.setVisited(true);
-                        }
-                        else if (!resultM->second.IsVisited()) {
-                            findInheritedAttributes(resultM->second);                     
-                            c.inheritAttribute(resultM->second.getNonPrivateAndInheritedAttribute(), pair.second);  
-                        }
-                    }
-                }
-            }      
-        }         
+            // Parent class is in another part of the project or in an external framework (already inherited)
+            const classModel* indexed = findExternalParentClass(pair.first, unitLanguage);
+            if (indexed) c.inheritAttribute(*indexed, pair.second);
+        }
     }
 }
 
@@ -447,57 +1360,101 @@ void classModelCollection::findInheritedAttributes(classModel& c) {
 void classModelCollection::findInheritedMethods(classModel& c) {   
     const std::string& unitLanguage = c.getUnitLanguage();
     c.setVisited(true); 
-    const std::unordered_map<std::string, std::string>& parentClassName =  c.getParentClassName();
+    const flatStringMap<std::string>& parentClassName =  c.getParentClassName();
 
     for (const auto& pair : parentClassName){
-        std::string parClassName = pair.first;
-        auto result = classCollection.find(parClassName);
-        if (result != classCollection.end()) {
-            if (result->second.HasInherited() && !result->second.IsVisited()) {
-                c.appendInheritedMethod(result->second.getMethodSignatures(), result->second.getInheritedMethodSignatures()); 
-                result->second.setVisited(true);
+        classModel* parent = findParentClass(pair.first, unitLanguage);
+        if (parent) {
+            if (parent->HasInherited() && !parent->IsVisited()) {
+                c.appendInheritedMethod(*parent); 
+                parent->setVisited(true);
             }
                 
-            else if (!result->second.IsVisited()) {
-                findInheritedMethods(result->second);                     
-                c.appendInheritedMethod(result->second.getMethodSignatures(), result->second.getInheritedMethodSignatures());  
+            else if (!parent->IsVisited()) {
+                findInheritedMethods(*parent);                     
+                c.appendInheritedMethod(*parent);  
             }
-        }       
+        }
         else {
-            if (unitLanguage == "C++") {
-                parClassName = parClassName.substr(0, parClassName.find("<"));
-                result = classCollection.find(parClassName);
-                if (result != classCollection.end()) {
-                    if (result->second.HasInherited() && !result->second.IsVisited()) {
-                        c.appendInheritedMethod(result->second.getMethodSignatures(), result->second.getInheritedMethodSignatures()); 
-                        result->second.setVisited(true);
-                    }
-                        
-                    else if (!result->second.IsVisited()) {
-                        findInheritedMethods(result->second);                     
-                        c.appendInheritedMethod(result->second.getMethodSignatures(), result->second.getInheritedMethodSignatures()); 
-                    }
-                }              
-            }
-            else {  
-                removeBetweenComma(parClassName, true);
-                auto resultG = classGenerics.find(parClassName);
-                if (resultG != classGenerics.end()) {
-                    auto resultM = classCollection.find(resultG->second);
-                    if (resultM != classCollection.end()) {
-                        if (resultM->second.HasInherited() && !resultM->second.IsVisited()) {
-                            c.appendInheritedMethod(resultM->second.getMethodSignatures(), resultM->second.getInheritedMethodSignatures());  
-                            resultM->second.setVisited(true);
-                        }
-                        else if (!resultM->second.IsVisited()) {
-                            findInheritedMethods(resultM->second);                     
-                            c.appendInheritedMethod(resultM->second.getMethodSignatures(), resultM->second.getInheritedMethodSignatures());   
-                        }
-                    }
-                }
-            }      
-        }         
+            // Parent class is in another part of the project or in an external framework (already inherited)
+            const classModel* indexed = findExternalParentClass(pair.first, unitLanguage);
+            if (indexed) c.appendInheritedMethod(*indexed);
+        }
+    }
+}
+
+// Finds the model of a parent class
+// In C++, the name is matched as is, then without the template arguments
+// In Java and C#, the name is matched as is, then using the generic class names
+// Returns nullptr if the parent class is not in the collection
+//
+classModel* classModelCollection::findParentClass(const std::string& parentName, const std::string& unitLanguage) {
+    auto result = classCollection.find(parentName);
+    if (result != classCollection.end()) return &result->second;
+
+    if (unitLanguage == "C++") {
+        result = classCollection.find(parentName.substr(0, parentName.find("<")));
+        if (result != classCollection.end()) return &result->second;
+    }
+    else {  
+        std::string parClassName = parentName;
+        removeBetweenComma(parClassName, true);
+        auto resultG = classGenerics.find(parClassName);
+        if (resultG != classGenerics.end()) {
+            result = classCollection.find(resultG->second);
+            if (result != classCollection.end()) return &result->second;
+        }
+    }
+    return nullptr;
+}
+
+// Finds the model of a parent class that is not in the collection
+// In streaming mode, the classes of the input archive are searched first (the parent class is in another group)
+// The project index and the module summaries are searched next, then the summary packs
+// Returns nullptr if the parent class is not found
+//
+const classModel* classModelCollection::findExternalParentClass(const std::string& parentName, const std::string& unitLanguage) const {
+    const classModel* parent = archiveIndex ? archiveIndex->findParentClass(parentName, unitLanguage) : nullptr;
+    if (!parent) parent = PROJECT_INDEX.findClass(parentName, unitLanguage);
+    if (!parent) parent = SUMMARY_PACKS.findClass(parentName, unitLanguage);
+    return parent;
+}
+
+// Writes the project index or the module summary
+// The project index contains all classes of the input archive, and the classes of the loaded 
+//  project index (if any) that are not in the input archive
+// The module summary contains the classes of the input archive only (classes of imported summaries are not included)
+//
+void classModelCollection::outputIndex(const std::string& indexFile, std::int64_t kind) {
+    std::ofstream out(indexFile, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error: Unable to write project index: " << indexFile << '\n';
+        return;
     }
+
+    std::vector<classModel> indexed;
+    if (kind == PROJECT_INDEX_KIND) {
+        for (const auto& pair : PROJECT_INDEX.getIndexedClasses()) {
+            if (classCollection.find(pair.first) != classCollection.end() || PROJECT_INDEX.isSummaryClass(pair.first)) continue;
+            indexed.push_back(pair.second.clone());
+            indexed.back().removeExternalMethods(inputFilenames);
+        }
+    }
+
+    out.write(PROJECT_INDEX_MAGIC.data(), PROJECT_INDEX_MAGIC.size());
+    writeInteger(out, PROJECT_INDEX_VERSION);
+    writeInteger(out, kind);
+    writeInteger(out, classCollection.size() + indexed.size());
+    for (auto& pair : classCollection) {
+        if (kind == MODULE_SUMMARY_KIND) pair.second.writeSummary(out);
+        else {
+            loadMethods(pair.second);
+            pair.second.writeIndex(out, unitFilenames);
+            limitMemory(false, false);
+        }
+    }
+    for (const auto& c : indexed)
+        c.writeIndex(out, unitFilenames);
 }
 
 // Generates other CSV report files containing stereotype information
@@ -507,62 +1464,11 @@ void classModelCollection::findInheritedMethods(classModel& c) {
 // This includes unique_class_view (e.g., 'entity control' ... etc)
 // This includes category_view (e.g., accessors, mutators ... etc) 
 //
-void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFileNoExt) {
-    std::unordered_map<std::string, int>            uniqueMethodStereotypesView;  
-    std::unordered_map<std::string, int>            uniqueClassStereotypesView;  
-
-    std::unordered_map<std::string, int> classStereotypes = {
-        {"entity", 0},
-        {"minimal-entity", 0},
-        {"data-provider", 0},
-        {"commander", 0},
-        {"boundary", 0},
-        {"factory", 0},
-        {"controller", 0},
-        {"pure-controller", 0},
-        {"large-class", 0},
-        {"lazy-class", 0},
-        {"degenerate", 0},
-        {"data-class", 0},
-        {"small-class", 0},
-        {"unclassified", 0},
-        {"empty", 0},
-    };
-
-    std::unordered_map<std::string, int> methodStereotypes = {
-        {"get", 0},
-        {"predicate", 0},
-        {"property", 0},
-        {"void-accessor", 0},
-        {"set", 0},
-        {"command", 0},
-        {"non-void-command", 0},
-        {"collaborator", 0},
-        {"controller", 0},
-        {"wrapper", 0},
-        {"constructor", 0},
-        {"copy-constructor", 0},
-        {"destructor", 0},
-        {"factory", 0},
-        {"incidental", 0},
-        {"stateless", 0},  
-        {"empty", 0},
-        {"unclassified", 0},
-    };
-
-    for (auto& pair : classCollection) {
-        uniqueClassStereotypesView[pair.second.getStereotype()]++; 
-        for (const std::string& s : pair.second.getStereotypeList()) 
-            classStereotypes[s]++;   
-        
-        const std::vector<methodModel>& method = pair.second.getMethods();     
-        for (const auto& m : method) {         
-            uniqueMethodStereotypesView[m.getStereotype()]++;
-
-            for (const std::string& s : m.getStereotypeList())
-                methodStereotypes[s]++;           
-        }
-    }
+void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFileNoExt, const stereotypeCounts& counts) {
+    const std::unordered_map<std::uint32_t, int>&   uniqueMethodStereotypesView = counts.uniqueMethodStereotypes;  
+    const std::unordered_map<std::uint32_t, int>&   uniqueClassStereotypesView = counts.uniqueClassStereotypes;  
+    const int*                                      classStereotypes = counts.classStereotypes;
+    const int*                                      methodStereotypes = counts.methodStereotypes;
 
     std::ofstream outU, outV, outM, outS, outC;
     outU.open(InputFileNoExt + ".unique_method_view.csv");
@@ -574,24 +1480,19 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     
 
     // Needed to print stereotypes in this order
-    std::vector<std::string> method_ordered_keys = {
-        "get", "predicate", "property", "void-accessor", "set", "command", "non-void-command", 
-        "collaborator", "controller", "wrapper", "constructor", "copy-constructor", "destructor", "factory", 
-        "incidental", "stateless", "empty", "unclassified"
-    };
-    
-    std::vector<std::string> class_ordered_keys = {
-        "entity", "minimal-entity", "data-provider", "commander", "boundary", "factory", 
-        "controller", "pure-controller", "large-class", "lazy-class", "degenerate", "data-class", 
-        "small-class", "empty", "unclassified"
+    std::vector<int> method_ordered_keys = {
+        STEREOTYPE_GET, STEREOTYPE_PREDICATE, STEREOTYPE_PROPERTY, STEREOTYPE_VOID_ACCESSOR, STEREOTYPE_SET, 
+        STEREOTYPE_COMMAND, STEREOTYPE_NON_VOID_COMMAND, STEREOTYPE_COLLABORATOR, STEREOTYPE_CONTROLLER, 
+        STEREOTYPE_WRAPPER, STEREOTYPE_CONSTRUCTOR, STEREOTYPE_COPY_CONSTRUCTOR, STEREOTYPE_DESTRUCTOR, 
+        STEREOTYPE_FACTORY, STEREOTYPE_INCIDENTAL, STEREOTYPE_STATELESS, STEREOTYPE_EMPTY, STEREOTYPE_UNCLASSIFIED
     };
 
     int total = 0;
     // Unique Method View
     if (outU.is_open()) {
         outU << "Unique Method Stereotype,Method Count" <<'\n';
-        for (auto& pair : uniqueMethodStereotypesView){
-            outU << pair.first << ",";
+        for (const auto& pair : uniqueMethodStereotypesView){
+            outU << stereotypeSet(STEREOTYPE_KIND_METHOD, pair.first).getString() << ",";
             outU << pair.second << '\n';
             total += pair.second;
         }
@@ -602,8 +1503,8 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     if (outV.is_open()) {   
         outV << "Unique Class Stereotype,Class Count" <<'\n';
         total = 0;
-        for (auto& pair : uniqueClassStereotypesView){
-            outV << pair.first << ",";
+        for (const auto& pair : uniqueClassStereotypesView){
+            outV << stereotypeSet(STEREOTYPE_KIND_CLASS, pair.first).getString() << ",";
             outV << pair.second << '\n';
             total += pair.second;
         }
@@ -615,8 +1516,8 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     if (outM.is_open()) { 
         outM << "Method Stereotype,Stereotype Count" <<'\n';
         total = 0;
-        for (const auto& key : method_ordered_keys) {
-            outM << key << ",";
+        for (int key : method_ordered_keys) {
+            outM << METHOD_STEREOTYPE_NAMES[key] << ",";
             outM << methodStereotypes[key] << '\n';
             total += methodStereotypes[key];
         }
@@ -628,8 +1529,8 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     if (outS.is_open()) {
         outS << "Class Stereotype,Stereotype Count" <<'\n';
         total = 0;
-        for (const auto& key : class_ordered_keys) {
-            outS << key << ",";
+        for (int key = 0; key < NUM_CLASS_STEREOTYPES; ++key) {
+            outS << CLASS_STEREOTYPE_NAMES[key] << ",";
             outS << classStereotypes[key] << '\n';
             total += classStereotypes[key];
         }
@@ -637,24 +1538,24 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     }
 
     // Category view
-    int getters = methodStereotypes["get"];
-    int accessors = getters + methodStereotypes["predicate"] +
-                    methodStereotypes["property"] +
-                    methodStereotypes["void-accessor"];
+    int getters = methodStereotypes[STEREOTYPE_GET];
+    int accessors = getters + methodStereotypes[STEREOTYPE_PREDICATE] +
+                    methodStereotypes[STEREOTYPE_PROPERTY] +
+                    methodStereotypes[STEREOTYPE_VOID_ACCESSOR];
 
-    int setters = methodStereotypes["set"];     
-    int commands = methodStereotypes["command"] + methodStereotypes["non-void-command"];           
+    int setters = methodStereotypes[STEREOTYPE_SET];     
+    int commands = methodStereotypes[STEREOTYPE_COMMAND] + methodStereotypes[STEREOTYPE_NON_VOID_COMMAND];           
     int mutators = setters + commands;
 
-    int controllers = methodStereotypes["controller"];
-    int collaborator =  methodStereotypes["collaborator"] + methodStereotypes["wrapper"]; 
+    int controllers = methodStereotypes[STEREOTYPE_CONTROLLER];
+    int collaborator =  methodStereotypes[STEREOTYPE_COLLABORATOR] + methodStereotypes[STEREOTYPE_WRAPPER]; 
     int collaborators = controllers + collaborator;
     
-    int factory = methodStereotypes["factory"] + methodStereotypes["constructor"] + methodStereotypes["copy-constructor"] + methodStereotypes["destructor"];
+    int factory = methodStereotypes[STEREOTYPE_FACTORY] + methodStereotypes[STEREOTYPE_CONSTRUCTOR] + methodStereotypes[STEREOTYPE_COPY_CONSTRUCTOR] + methodStereotypes[STEREOTYPE_DESTRUCTOR];
 
-    int degenerates = methodStereotypes["incidental"] + methodStereotypes["stateless"] + methodStereotypes["empty"]; 
+    int degenerates = methodStereotypes[STEREOTYPE_INCIDENTAL] + methodStereotypes[STEREOTYPE_STATELESS] + methodStereotypes[STEREOTYPE_EMPTY]; 
 
-    int unclassified = methodStereotypes["unclassified"];
+    int unclassified = methodStereotypes[STEREOTYPE_UNCLASSIFIED];
 
     total = accessors + mutators + factory + collaborators + degenerates + unclassified;
     outC << "Stereotype Category,Stereotype Count" <<'\n';
@@ -673,6 +1574,27 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
     outC.close();
 }
 
+// Adds the class and method stereotypes of the collection to the counts of the verbose report files
+//
+void classModelCollection::countStereotypes(stereotypeCounts& counts) {
+    for (auto& pair : classCollection) {
+        loadMethods(pair.second);
+        const stereotypeSet& classStereotype = pair.second.getStereotypeSet();
+        counts.uniqueClassStereotypes[classStereotype.getMask()]++; 
+        for (int s = 0; s < NUM_CLASS_STEREOTYPES; ++s) 
+            counts.classStereotypes[s] += classStereotype.has(s);   
+        
+        const std::vector<methodModel>& method = pair.second.getMethods();     
+        for (const auto& m : method) {         
+            const stereotypeSet& methodStereotype = m.getStereotypeSet();
+            counts.uniqueMethodStereotypes[methodStereotype.getMask()]++;
+            for (int s = 0; s < NUM_METHOD_STEREOTYPES; ++s)
+                counts.methodStereotypes[s] += methodStereotype.has(s);           
+        }
+        limitMemory(false, false);
+    }
+}
+
 // Optional TXT report file containing stereotype information
 // Format:
 //
@@ -686,10 +1608,11 @@ void classModelCollection::outputCsvVerboseReportFile(const std::string& InputFi
 // Method Name:             Method Stereotype:
 // ...                      ...
 //
-void classModelCollection::outputTxtReportFile(std::stringstream& stringStream, classModel* c) {
-    const int WIDTH = 70;
-    const std::string line(WIDTH * 2, '-');
-    auto setw_width = std::setw(WIDTH);
+// If table is false, only the rows of the free functions are written (streaming mode 
+//  writes the header and the closing line of the free functions once)
+//
+void classModelCollection::outputTxtReportFile(std::ostream& stringStream, classModel* c, bool table) {
+    auto setw_width = std::setw(TXT_REPORT_WIDTH);
     std::vector<methodModel>* methods = &freeFunctions;
 
     if (c != nullptr) {
@@ -700,8 +1623,8 @@ void classModelCollection::outputTxtReportFile(std::stringstream& stringStream,
         stringStream << std::left << setw_width << "Method Name:" << setw_width << "Method Stereotype:" << '\n';
         methods = &c->getMethods();
     }
-    else 
-        stringStream << std::left << setw_width << "Free Function Name:" << setw_width << "Free Function Stereotype:" << '\n';
+    else if (table)
+        outputTxtFreeFunctionHeader(stringStream);
 
     
     for (const auto& m : *methods) {
@@ -709,12 +1632,12 @@ void classModelCollection::outputTxtReportFile(std::stringstream& stringStream,
         stringStream << std::left << setw_width << methodName; 
         stringStream << setw_width << m.getStereotype() << '\n';
     }
-    stringStream << line << '\n'; 
+    if (c != nullptr || table) stringStream << TXT_REPORT_LINE << '\n'; 
 }
 
 // Optional CSV report file containing stereotype information
 //
-void classModelCollection::outputCsvReportFile(std::ofstream& out, classModel* c) {
+void classModelCollection::outputCsvReportFile(std::ostream& out, classModel* c) {
     std::vector<methodModel>* methods = &freeFunctions;
 
     std::string classInfo;
@@ -764,6 +1687,37 @@ void classModelCollection::outputWithStereotypes(srcml_unit* unit, std::map<int,
         srcml_archive_free(archive);
 }
 
+// Annotates stereotypes as comments in the output archive
+// The output archive is rewritten in place
+//
+void classModelCollection::outputCommentArchive(const std::string& outputFile) {
+    std::string temp = outputFile + ".temp.xml";
+
+    srcml_archive* archive = srcml_archive_create();
+    srcml_archive_read_open_filename(archive, outputFile.c_str());  
+
+    srcml_archive* outputArchive = srcml_archive_create();
+    srcml_archive_write_open_filename(outputArchive, temp.c_str());
+    srcml_archive_register_namespace(outputArchive, "st", "http://www.srcML.org/srcML/stereotype"); 
+
+    srcml_unit* unit = srcml_archive_read_unit(archive);
+
+    // Read all units in an archive
+    while (unit) {
+        outputAsComments(unit, outputArchive);
+        srcml_unit_free(unit);
+        unit = srcml_archive_read_unit(archive);
+    }
+
+    srcml_archive_close(archive); 
+    srcml_archive_free(archive);
+    srcml_archive_close(outputArchive);
+    srcml_archive_free(outputArchive);   
+
+    std::filesystem::remove(outputFile);
+    std::filesystem::rename(temp, outputFile);
+}
+
 // Inserts the stereotype as a comment before each function or class tag
 // For example, /** @stereotype get */
 // last_ws is used to preserve to the whitespace that precedes each function or class
@@ -826,75 +1780,60 @@ void classModelCollection::outputAsComments(srcml_unit* unit, srcml_archive* out
 
 
 void classModelCollection::computeFreeFunctionsStereotypes() {
-    for (methodModel& f : freeFunctions) {
-        std::string methodName = f.getName();
+    methodFeatures features;
+    for (const methodModel& f : freeFunctions)
+        features.addMethod(f, -1, "", f.getUnitLanguage());
+
+    for (std::size_t row = 0; row < freeFunctions.size(); ++row) {
+        methodModel& f = freeFunctions[row];
+        stereotypeSet stereotype(STEREOTYPE_KIND_FUNCTION);
         // main
-        if (methodName == "main" || methodName == "Main")
-            f.setStereotype("main");
+        if (features.mainFunction[row])
+            stereotype.add(FUNCTION_STEREOTYPE_MAIN);
         // empty
-        else if (f.IsEmpty()) 
-                f.setStereotype("empty");
+        else if (features.empty[row]) 
+                stereotype.add(FUNCTION_STEREOTYPE_EMPTY);
         else {
             // predicate
-            bool returnType = false;
-            const std::string& returnTypeParsed = f.getReturnTypeParsed();
-            const std::string& unitLanguage = f.getUnitLanguage();
-
-            if (unitLanguage == "C++")
-                returnType = (returnTypeParsed == "bool");
-            else if (unitLanguage == "C#")
-                returnType = (returnTypeParsed == "bool") || 
-                            (returnTypeParsed == "Boolean");
-            else if (unitLanguage == "Java")
-                returnType = (returnTypeParsed == "boolean");
+            bool hasComplexReturnExpr = features.parameterNotReturned[row];
+            bool isParamaterUsed = features.parameterUsed[row];
 
-            bool hasComplexReturnExpr = f.IsParameterNotReturned();
-            bool isParamaterUsed = f.IsParameterUsed();
-
-            if (returnType && hasComplexReturnExpr && isParamaterUsed)
-                f.setStereotype("predicate"); 
+            if (features.returnBool[row] && hasComplexReturnExpr && isParamaterUsed)
+                stereotype.add(FUNCTION_STEREOTYPE_PREDICATE); 
 
             // property
-            returnType = false;
-            if (unitLanguage == "C++")
-                returnType = (returnTypeParsed != "bool" && returnTypeParsed != "void" && returnTypeParsed != "");
-            else if (unitLanguage == "C#")
-                returnType = (returnTypeParsed != "bool" && returnTypeParsed != "Boolean" &&
-                            returnTypeParsed != "void" && returnTypeParsed != "Void" && returnTypeParsed != "");
-            else if (unitLanguage == "Java")
-                returnType = (returnTypeParsed != "boolean" && returnTypeParsed != "void" && 
-                            returnTypeParsed != "Void" && returnTypeParsed != "");
-
+            bool returnType = !features.returnBool[row] && !features.returnVoidOrEmpty[row];
             if (returnType && hasComplexReturnExpr && isParamaterUsed)
-                f.setStereotype("property"); 
+                stereotype.add(FUNCTION_STEREOTYPE_PROPERTY); 
             
             // factory
-            if(f.IsFactory() || f.IsStrictFactory())
-                f.setStereotype("factory");   
+            if (features.factory[row])
+                stereotype.add(FUNCTION_STEREOTYPE_FACTORY);   
 
             // global-command
-            bool globalOrStaticChanged = f.IsGlobalOrStaticChanged();
+            bool globalOrStaticChanged = features.globalOrStaticChanged[row];
             if (globalOrStaticChanged)
-                f.setStereotype("global-command");
+                stereotype.add(FUNCTION_STEREOTYPE_GLOBAL_COMMAND);
             
             // command
-            bool parameterModified = f.IsParameterRefChanged();
+            bool parameterModified = features.parameterRefChanged[row];
             if (parameterModified && !globalOrStaticChanged)
-                f.setStereotype("command");
+                stereotype.add(FUNCTION_STEREOTYPE_COMMAND);
 
             // literal
             if (!isParamaterUsed)
-                f.setStereotype("literal");
+                stereotype.add(FUNCTION_STEREOTYPE_LITERAL);
 
             // wrapper           
-            bool hasCalls = (f.getFunctionCalls().size() + f.getMethodCalls().size()) > 0;
+            bool hasCalls = (features.numOfFunctionCalls[row] + features.numOfMethodCalls[row]) > 0;
             if (!parameterModified && hasCalls)
-                f.setStereotype("wrapper");
+                stereotype.add(FUNCTION_STEREOTYPE_WRAPPER);
 
             // unclassified
-            if (f.getStereotype() == "") 
-                f.setStereotype("unclassified");
+            if (stereotype.empty()) 
+                stereotype.add(FUNCTION_STEREOTYPE_UNCLASSIFIED);
         }
+        f.setStereotype(stereotype);
         XPATH_LIST[f.getUnitNumber()].insert({f.getXpath(), f.getStereotype()});
     }
 }
\ No newline at end of file
@@ -14,33 +14,96 @@
 #include <iomanip> 
 #include <mutex>
 #include <filesystem>
-#include "ClassModel.hpp"
+#include <fstream>
+#include <memory_resource>
+#include "ProjectIndex.hpp"
+
+const std::string        CHECKPOINT_MAGIC        = "STEREOCODE-CHECKPOINT";
+const std::int64_t       CHECKPOINT_VERSION      = 6;
+
+// Stereotype counts of the verbose report files
+// Unique views are indexed by stereotype bitmask, the other counts by stereotype bit
+//
+struct stereotypeCounts {
+    std::unordered_map<std::uint32_t, int>          uniqueMethodStereotypes;
+    std::unordered_map<std::uint32_t, int>          uniqueClassStereotypes;
+    int                                             classStereotypes[NUM_CLASS_STEREOTYPES] = {};
+    int                                             methodStereotypes[NUM_METHOD_STEREOTYPES] = {};
+};
 
 class classModelCollection {
 public:
-                         classModelCollection           (srcml_archive*, srcml_archive*, const std::string&, const std::string&, bool, bool, bool);
+                         classModelCollection           () = default;
+                         classModelCollection           (srcml_archive*, srcml_archive*, const std::string&, const std::string&, bool, bool, bool,
+                                                         const std::string& = "", const std::string& = "");
 
     void                 findClassInfo                  (srcml_archive*, srcml_unit*, int);
     void                 findFreeFunctions              (srcml_archive*, srcml_unit*, int);
     void                 findInheritedAttributes        (classModel&);
     void                 findInheritedMethods           (classModel&);
+    classModel*          findParentClass                (const std::string&, const std::string&);
+    const classModel*    findExternalParentClass        (const std::string&, const std::string&) const;
+    classModel*          findFreeFunctionClass          (const methodModel&);
+    std::vector<std::string> findFreeFunctionClassNames (const methodModel&) const;
 
     void                 outputWithStereotypes          (srcml_unit*, std::map<int, srcml_unit*>&,
                                                          int, const std::unordered_map<std::string, std::string>&,  
                                                          std::unordered_map<int, srcml_transform_result*>&, std::mutex&);
     void                 outputAsComments               (srcml_unit*, srcml_archive*) ;                            
-    void                 outputTxtReportFile            (std::stringstream&, classModel*);
-    void                 outputCsvReportFile            (std::ofstream&, classModel*);
-    void                 outputCsvVerboseReportFile     (const std::string&);
+    void                 outputCommentArchive           (const std::string&);
+    void                 outputReports                  (const std::string&, bool, bool);
+    void                 outputTxtReportFile            (std::ostream&, classModel*, bool = true);
+    void                 outputCsvReportFile            (std::ostream&, classModel*);
+    void                 outputCsvVerboseReportFile     (const std::string&, const stereotypeCounts&);
+    void                 countStereotypes               (stereotypeCounts&);
+    void                 outputIndex                    (const std::string&, std::int64_t);
 
     bool                 isFriendFunction               (methodModel&);
     void                 computeFreeFunctionsStereotypes();
-    void                 analyzeFreeFunctions();
+    void                 computeStereotypes             (bool = true);
+    void                 analyzeFreeFunctions           (std::vector<methodModel>&);
+    void                 analyzeClasses                 (const std::unordered_set<std::string>*);
+    void                 findFreeFunctionsData          (std::vector<methodModel>&);
+    void                 writeCheckpoint                (const std::string&, const std::string&, int);
+    void                 readCheckpoint                 (const std::string&, std::string&, int&);
+    void                 writeOutputCheckpoint          (unsigned int, int);
+    void                 readOutputCheckpoint           (unsigned int&, int&);
+    srcml_archive*       openSegment                    (srcml_archive*, int);
+    void                 mergeSegments                  (srcml_archive*, int);
+    std::size_t          updateUnits                    (const std::map<int, classModelCollection>&, const std::unordered_set<int>&);
+
+    void                 streamStereotypes              (srcml_archive*, srcml_archive*, const std::string&, const std::string&, bool, bool, bool,
+                                                         const std::string& = "");
+    int                  indexArchive                   (srcml_archive*);
+    void                 findInheritance                (const std::unordered_set<std::string>*);
+    void                 analyzeGroup                   (classModelCollection&);
+    void                 outputStreamUnits              (srcml_archive*, srcml_archive*, unsigned int&, unsigned int);
+
+    void                 openSpillFile                  (const std::string&);
+    void                 closeSpillFile                 ();
+    void                 limitMemory                    (bool, bool);
+    void                 spillModels                    (bool, bool);
+    void                 spillLoadedModels              ();
+    void                 loadMethods                    (classModel&);
+    void                 analyzeSpilledFreeFunctions    ();
     
 private:
-    std::unordered_map<std::string, classModel>     classCollection;    // List of class names and their models
-    std::unordered_map<std::string, std::string>    classGenerics;      // List of generic class names with and without <> for inheritance matching
+    flatStringMap<classModel>                       classCollection;    // List of class names and their models
+    flatStringMap<std::string>                      classGenerics;      // List of generic class names with and without <> for inheritance matching
     std::vector<methodModel>                        freeFunctions;      // List of free functions
+    std::unordered_map<int, std::string>            unitFilenames;      // Key is unit number and value is the file name of the unit
+    std::unordered_set<std::string>                 inputFilenames;     // File names of all units in the input archive
+    std::vector<int>                                unitGroups;         // Streaming mode. First unit of the group of each unit (units that share a class are analyzed together)
+    std::vector<int>                                groupLastUnit;      // Streaming mode. Last unit of each group (indexed by the first unit of the group)
+    classModelCollection*                           archiveIndex{nullptr}; // Streaming mode. Classes of the whole archive (used for parent classes in other groups)
+    std::fstream                                    spillFile;          // Memory cap. Methods written out of memory (--max-memory)
+    std::string                                     spillFilename;      // Memory cap. File name of the spill file
+    std::vector<std::int64_t>                       spilledFreeFunctions; // Memory cap. Offsets of the free functions in the spill file
+    std::size_t                                     residentSize{0};    // Memory cap. Estimated size of the methods in memory that can be spilled
+    std::int64_t                                    inputHash{0};       // Checkpoints. Hash of the contents of the input archive
+    int                                             checkpointUnit{0};  // Checkpoints. First unit not in the checkpoint file (0 if no checkpoint was written or read)
+    std::size_t                                     checkpointFunctions{0}; // Checkpoints. Number of free functions in the checkpoint file
+    std::unordered_set<std::string>                 checkpointClasses;  // Checkpoints. Classes collected since the last checkpoint
 };
 
 #endif
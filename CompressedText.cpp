@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file CompressedText.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "CompressedText.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+// Limits of the LZ4 block format
+//
+static const std::size_t    MIN_MATCH               = 4;               // Shortest match that is encoded
+static const std::size_t    LAST_LITERALS           = 5;               // The last bytes are always literals
+static const std::size_t    MATCH_FIND_LIMIT        = 12;              // No match starts in the last bytes
+static const std::size_t    MAX_OFFSET              = 65535;
+static const int            HASH_BITS               = 12;
+
+static std::uint32_t read32(const char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static std::size_t hash(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Lengths of 15 or more continue in the following bytes (255 means more bytes follow)
+//
+static void writeLength(std::string& out, std::size_t length) {
+    for (; length >= 255; length -= 255) out += static_cast<char>(255);
+    out += static_cast<char>(length);
+}
+
+// Writes literals followed by a match (no match if matchLength is 0, only for the last literals)
+//
+static void writeSequence(std::string& out, const char* literals, std::size_t literalLength,
+                          std::size_t offset, std::size_t matchLength) {
+    std::size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    unsigned char token = static_cast<unsigned char>((std::min<std::size_t>(literalLength, 15) << 4) |
+                                                      std::min<std::size_t>(matchCode, 15));
+    out += static_cast<char>(token);
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.append(literals, literalLength);
+    if (!matchLength) return;
+
+    out += static_cast<char>(offset & 0xFF);
+    out += static_cast<char>(offset >> 8);
+    if (matchCode >= 15) writeLength(out, matchCode - 15);
+}
+
+compressedText::compressedText(std::string_view text) : size(text.size()) {
+    const char* src = text.data();
+    std::size_t n = text.size();
+    data.reserve(n / 2 + 16);
+
+    std::size_t anchor = 0;
+    if (n > MATCH_FIND_LIMIT) {
+        // Positions are stored + 1, so 0 means empty
+        std::vector<std::uint32_t> table(std::size_t(1) << HASH_BITS, 0);
+        std::size_t matchStartLimit = n - MATCH_FIND_LIMIT;
+        std::size_t matchEndLimit = n - LAST_LITERALS;
+
+        for (std::size_t ip = 0; ip < matchStartLimit;) {
+            std::uint32_t sequence = read32(src + ip);
+            std::size_t slot = hash(sequence);
+            std::size_t candidate = table[slot];
+            table[slot] = ip + 1;
+
+            if (candidate == 0 || ip - (candidate - 1) > MAX_OFFSET || read32(src + candidate - 1) != sequence) {
+                ++ip;
+                continue;
+            }
+            std::size_t ref = candidate - 1;
+            std::size_t length = MIN_MATCH;
+            while (ip + length < matchEndLimit && src[ref + length] == src[ip + length]) ++length;
+
+            writeSequence(data, src + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+    writeSequence(data, src + anchor, n - anchor, 0, 0);
+    data.shrink_to_fit();
+}
+
+// Returns the original text
+// Returns an empty string if the compressed data is invalid (e.g., a damaged checkpoint)
+//
+std::string compressedText::decompress() const {
+    std::string text(size, '\0');
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(data.data());
+    const unsigned char* end = ip + data.size();
+    std::size_t op = 0;
+
+    // Reads the rest of a length of 15 or more
+    auto readLength = [&](std::size_t& length) {
+        unsigned char b = 255;
+        while (b == 255 && ip < end) {
+            b = *ip++;
+            length += b;
+        }
+        return b != 255;
+    };
+
+    while (ip < end) {
+        unsigned char token = *ip++;
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) break;
+        if (literalLength > std::size_t(end - ip) || literalLength > size - op) break;
+        std::memcpy(&text[op], ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // The last sequence has literals only
+        if (ip == end) {
+            if (op == size) return text;
+            break;
+        }
+
+        if (end - ip < 2) break;
+        std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(matchLength)) break;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > op || matchLength > size - op) break;
+
+        // Byte by byte, since the match can overlap the bytes it writes
+        for (std::size_t i = 0; i < matchLength; ++i, ++op)
+            text[op] = text[op - offset];
+    }
+
+    if (size == 0 && data.empty()) return text;
+    std::cerr << "Error: Invalid compressed text" << '\n';
+    return std::string();
+}
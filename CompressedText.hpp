@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file CompressedText.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef COMPRESSEDTEXT_HPP
+#define COMPRESSEDTEXT_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Text kept in memory compressed and decompressed on demand
+// Uses the LZ4 block format (greedy matching, no dictionary). srcML is mostly repeated
+//  tags, so it typically shrinks to a fraction of its size
+//
+class compressedText {
+public:
+                         compressedText          () = default;
+    explicit             compressedText          (std::string_view);
+                         compressedText          (std::string c, std::size_t s) : data(std::move(c)), size(s) {}
+
+    std::string          decompress              () const;
+    void                 release                 ()                     { data.clear(); data.shrink_to_fit(); size = 0; }
+    bool                 empty                   () const               { return size == 0;                             }
+    std::size_t          getSize                 () const               { return size;                                  }
+    const std::string&   getData                 () const               { return data;                                  }
+
+private:
+    std::string          data;                                          // Compressed bytes
+    std::size_t          size{0};                                       // Size of the text before compression
+};
+
+#endif
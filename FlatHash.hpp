@@ -0,0 +1,467 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file FlatHash.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef FLATHASH_HPP
+#define FLATHASH_HPP
+
+#include <memory>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <tuple>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <initializer_list>
+
+// Open addressing hash table (Robin Hood hashing) used by flatHashMap and flatHashSet
+// Elements are stored in one array of slots, so inserting does not allocate a node and
+//  a lookup reads consecutive slots instead of following pointers
+// Each slot keeps its distance from the slot the key hashes to. An insert takes the slot of
+//  any element that is closer to its own slot (shifting the rest of the cluster by one), so
+//  distances stay short and a lookup stops as soon as it sees an element closer than the key
+// The slot array does not wrap around. It ends with probeLimit extra slots and the table grows
+//  when an element would be further than probeLimit from its slot. If the table is less than half full,
+//  the keys collide (e.g., same hash) and doubling would not separate them, so probeLimit is doubled instead.
+//  Many colliding keys then make lookups slower (as in the chain of a node based table) but not the table larger
+// Erase shifts the following elements back (no tombstones)
+// Slots keep the hash of their key, so keys are only compared when hashes match (keys that share
+//  a long prefix, like xpaths, are expensive to compare) and are never hashed again when the table grows
+// Unlike std::unordered_map, inserting or erasing moves elements, so pointers, references,
+//  and iterators to elements are invalidated. Iteration order is unspecified
+//
+template <typename Value, typename Key, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+class flatHashTable {
+    struct slot {
+        std::uint32_t    distance;                       // 0 if empty, else 1 + distance from the slot of the key
+        std::uint32_t    hash;                           // Hash of the key (folded to 32 bits)
+        union { Value    value; };
+                         slot                   () : distance(0) {}
+                         ~slot                  () {}
+    };
+    using slotAllocator  = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+    using slotTraits     = std::allocator_traits<slotAllocator>;
+    using valueTraits    = std::allocator_traits<Allocator>;
+
+public:
+    using key_type       = Key;
+    using value_type     = Value;
+    using size_type      = std::size_t;
+    using hasher         = Hash;
+    using key_equal      = KeyEqual;
+    using allocator_type = Allocator;
+
+    template <bool IsConst>
+    class basicIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Value;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<IsConst, const Value*, Value*>;
+        using reference         = std::conditional_t<IsConst, const Value&, Value&>;
+
+                         basicIterator          () = default;
+        explicit         basicIterator          (slot* s) : current(s) {}
+        template <bool C = IsConst, typename = std::enable_if_t<C>>
+                         basicIterator          (const basicIterator<false>& it) : current(it.current) {}
+
+        reference        operator*              () const { return current->value;  }
+        pointer          operator->             () const { return &current->value; }
+        basicIterator&   operator++             ()       { do ++current; while (current->distance == 0); return *this; }
+        basicIterator    operator++             (int)    { basicIterator it = *this; ++*this; return it; }
+        bool             operator==             (const basicIterator& it) const { return current == it.current; }
+        bool             operator!=             (const basicIterator& it) const { return current != it.current; }
+
+    private:
+        friend class flatHashTable;
+        template <bool> friend class basicIterator;
+        slot*            current{nullptr};
+    };
+    using iterator       = basicIterator<false>;
+    using const_iterator = basicIterator<true>;
+
+                         flatHashTable          () = default;
+    explicit             flatHashTable          (const Allocator& a) : alloc(a) {}
+    template <typename InputIt>
+                         flatHashTable          (InputIt first, InputIt last) { insert(first, last); }
+                         flatHashTable          (const flatHashTable& other)
+                                                 : alloc(slotTraits::select_on_container_copy_construction(other.alloc)) { copyFrom(other); }
+                         flatHashTable          (flatHashTable&& other) noexcept : alloc(std::move(other.alloc)) { steal(other); }
+                         ~flatHashTable         () { destroy(); }
+
+    flatHashTable& operator=(const flatHashTable& other) {
+        if (this == &other) return *this;
+        destroy();
+        if constexpr (slotTraits::propagate_on_container_copy_assignment::value) alloc = other.alloc;
+        copyFrom(other);
+        return *this;
+    }
+
+    flatHashTable& operator=(flatHashTable&& other) {
+        if (this == &other) return *this;
+        if (slotTraits::propagate_on_container_move_assignment::value || alloc == other.alloc) {
+            destroy();
+            if constexpr (slotTraits::propagate_on_container_move_assignment::value) alloc = std::move(other.alloc);
+            steal(other);
+        }
+        else {
+            // Elements cannot change allocators (e.g., different memory resources), so they are moved one by one
+            clear();
+            reserve(other.size());
+            for (Value& v : other) insert(std::move(v));
+            other.clear();
+        }
+        return *this;
+    }
+
+    iterator             begin                  ()       { return iterator(firstSlot());                      }
+    iterator             end                    ()       { return iterator(slots ? slots + sentinel() : nullptr); }
+    const_iterator       begin                  () const { return const_iterator(firstSlot());                }
+    const_iterator       end                    () const { return const_iterator(slots ? slots + sentinel() : nullptr); }
+
+    size_type            size                   () const { return elements;                                  }
+    bool                 empty                  () const { return elements == 0;                             }
+    size_type            bucket_count           () const { return buckets;                                   }
+    allocator_type       get_allocator          () const { return Allocator(alloc);                          }
+
+    iterator             find                   (const Key& key)       { return iterator(findSlot(key));              }
+    const_iterator       find                   (const Key& key) const { return const_iterator(findSlot(key));        }
+    size_type            count                  (const Key& key) const { return findSlot(key) != endSlot();           }
+
+    // Lookup with a key of another type (e.g., std::string_view for std::string keys) if Hash and KeyEqual support it
+    template <typename K, typename H = Hash, typename = typename H::is_transparent>
+    iterator             find                   (const K& key)         { return iterator(findSlot(key));              }
+    template <typename K, typename H = Hash, typename = typename H::is_transparent>
+    const_iterator       find                   (const K& key) const   { return const_iterator(findSlot(key));        }
+    template <typename K, typename H = Hash, typename = typename H::is_transparent>
+    size_type            count                  (const K& key) const   { return findSlot(key) != endSlot();           }
+
+    std::pair<iterator, bool> insert(const Value& v) { return emplaceKey(KeyOf()(v), v);                             }
+    std::pair<iterator, bool> insert(Value&& v)      { return emplaceKey(KeyOf()(v), std::move(v));                  }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        Value v(std::forward<Args>(args)...);
+        return insert(std::move(v));
+    }
+
+    size_type erase(const Key& key) {
+        slot* s = findSlot(key);
+        if (s == endSlot()) return 0;
+        eraseSlot(s);
+        return 1;
+    }
+
+    // Returns the iterator following the erased element. The following elements are shifted back, so
+    //  it is the same position unless it is now empty
+    iterator erase(const_iterator it) {
+        slot* s = it.current;
+        eraseSlot(s);
+        while (s->distance == 0) ++s;
+        return iterator(s);
+    }
+
+    void clear() {
+        if (!slots) return;
+        for (size_type i = 0; i < sentinel(); ++i) {
+            if (slots[i].distance == 0) continue;
+            destroyValue(slots[i]);
+            slots[i].distance = 0;
+        }
+        elements = 0;
+    }
+
+    // Makes room for n elements without growing
+    void reserve(size_type n) {
+        size_type newBuckets = MIN_BUCKETS;
+        while (n > maxLoad(newBuckets)) newBuckets *= 2;
+        if (newBuckets > buckets) rehash(newBuckets, probeLimit);
+    }
+
+    // Same elements, in any order
+    bool operator==(const flatHashTable& other) const {
+        if (elements != other.elements) return false;
+        for (const_iterator it = begin(); it != end(); ++it) {
+            slot* s = other.findSlot(KeyOf()(*it), it.current->hash);
+            if (s == other.endSlot() || !(s->value == *it)) return false;
+        }
+        return true;
+    }
+    bool operator!=(const flatHashTable& other) const { return !(*this == other); }
+
+protected:
+    // Inserts an element constructed from args if key is not in the table
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> emplaceKey(const K& key, Args&&... args) {
+        if (!slots) rehash(MIN_BUCKETS, 0);
+        std::uint32_t h = fold(Hash()(key));
+        while (true) {
+            size_type i = home(h);
+            std::uint32_t d = 1;
+            for (; slots[i].distance >= d; ++i, ++d)
+                if (slots[i].hash == h && KeyEqual()(KeyOf()(slots[i].value), key)) return {iterator(slots + i), false};
+
+            if (elements + 1 <= maxLoad(buckets) && makeRoom(i, d, h)) {
+                constructValue(slots[i], std::forward<Args>(args)...);
+                ++elements;
+                return {iterator(slots + i), true};
+            }
+            grow();
+        }
+    }
+
+private:
+    static const size_type      MIN_BUCKETS = 4;
+
+    // Load factor of 0.8
+    static size_type     maxLoad                (size_type n)        { return n * 4 / 5;                          }
+    size_type            sentinel               () const             { return buckets + probeLimit;               }
+    slot*                endSlot                () const             { return slots ? slots + sentinel() : nullptr; }
+
+    static std::uint32_t fold                   (std::size_t h) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(h) ^ (static_cast<std::uint64_t>(h) >> 32));
+    }
+
+    // Fibonacci hashing spreads keys with poor hashes (e.g., std::hash of an integer is the integer)
+    size_type            home                   (std::uint32_t h) const {
+        return static_cast<size_type>((h * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    slot* firstSlot() const {
+        if (!slots) return nullptr;
+        slot* s = slots;
+        while (s->distance == 0) ++s;
+        return s;
+    }
+
+    template <typename K>
+    slot* findSlot(const K& key) const {
+        if (!slots) return nullptr;
+        return findSlot(key, fold(Hash()(key)));
+    }
+
+    template <typename K>
+    slot* findSlot(const K& key, std::uint32_t h) const {
+        if (!slots) return nullptr;
+        size_type i = home(h);
+        for (std::uint32_t d = 1; slots[i].distance >= d; ++i, ++d)
+            if (slots[i].hash == h && KeyEqual()(KeyOf()(slots[i].value), key)) return slots + i;
+        return endSlot();
+    }
+
+    // Empties slot i for an element at distance d by shifting the rest of the cluster by one slot
+    // Returns false (and changes nothing) if an element would end up further than probeLimit
+    bool makeRoom(size_type i, std::uint32_t d, std::uint32_t h) {
+        if (d > probeLimit) return false;
+        size_type j = i;
+        for (; j < sentinel() && slots[j].distance != 0; ++j)
+            if (slots[j].distance >= probeLimit) return false;
+        if (j == sentinel()) return false;
+
+        for (; j > i; --j) {
+            constructValue(slots[j], std::move(slots[j - 1].value));
+            slots[j].distance = slots[j - 1].distance + 1;
+            slots[j].hash = slots[j - 1].hash;
+            destroyValue(slots[j - 1]);
+        }
+        slots[i].distance = d;
+        slots[i].hash = h;
+        return true;
+    }
+
+    void eraseSlot(slot* s) {
+        destroyValue(*s);
+        for (; s[1].distance > 1; ++s) {
+            constructValue(*s, std::move(s[1].value));
+            s->distance = s[1].distance - 1;
+            s->hash = s[1].hash;
+            destroyValue(s[1]);
+        }
+        s->distance = 0;
+        --elements;
+    }
+
+    // Called when an element can't be placed
+    // The table doubles when it is full or at least half full. Otherwise the element is in a cluster of keys
+    //  that doubling would not split up (keys with the same hash, or hashes that share their top bits), so
+    //  the extra slots at the end are doubled instead and the cluster can be as long as the keys need
+    void grow() {
+        if (elements + 1 > maxLoad(buckets) || elements * 2 >= buckets) rehash(buckets * 2, probeLimit);
+        else rehash(buckets, probeLimit * 2);
+    }
+
+    // Moves all elements to a table with newBuckets slots and at least minProbeLimit extra slots
+    void rehash(size_type newBuckets, std::uint32_t minProbeLimit) {
+        slot*        oldSlots = slots;
+        size_type    oldSize = slots ? sentinel() + 1 : 0;
+        size_type    oldSentinel = slots ? sentinel() : 0;
+
+        allocate(newBuckets, minProbeLimit);
+        for (size_type i = 0; i < oldSentinel; ++i) {
+            if (oldSlots[i].distance == 0) continue;
+            moveIn(oldSlots[i].hash, std::move(oldSlots[i].value));
+            destroyValue(oldSlots[i]);
+        }
+        deallocate(oldSlots, oldSize);
+    }
+
+    // Inserts an element whose key is known not to be in the table (used by rehash)
+    void moveIn(std::uint32_t h, Value&& v) {
+        while (true) {
+            size_type i = home(h);
+            std::uint32_t d = 1;
+            for (; slots[i].distance >= d; ++i, ++d) {}
+
+            if (elements + 1 <= maxLoad(buckets) && makeRoom(i, d, h)) {
+                constructValue(slots[i], std::move(v));
+                ++elements;
+                return;
+            }
+            grow();
+        }
+    }
+
+    void allocate(size_type newBuckets, std::uint32_t minProbeLimit) {
+        buckets = newBuckets;
+        int bits = 0;
+        while ((size_type(1) << bits) < buckets) ++bits;
+        shift = 64 - bits;
+        probeLimit = static_cast<std::uint32_t>(bits < 8 ? 8 : bits);
+        if (probeLimit < minProbeLimit) probeLimit = minProbeLimit;
+        slots = slotTraits::allocate(alloc, sentinel() + 1);
+        for (size_type i = 0; i <= sentinel(); ++i)
+            slotTraits::construct(alloc, slots + i);
+        slots[sentinel()].distance = 1;  // Stops iteration and backward shifts
+        elements = 0;
+    }
+
+    void deallocate(slot* s, size_type n) {
+        if (!s) return;
+        for (size_type i = 0; i < n; ++i) slotTraits::destroy(alloc, s + i);
+        slotTraits::deallocate(alloc, s, n);
+    }
+
+    void destroy() {
+        clear();
+        deallocate(slots, slots ? sentinel() + 1 : 0);
+        slots = nullptr;
+        buckets = 0;
+    }
+
+    // Same slots as other, so no element has to be hashed again
+    void copyFrom(const flatHashTable& other) {
+        if (!other.slots) return;
+        allocate(other.buckets, other.probeLimit);
+        for (size_type i = 0; i < sentinel(); ++i) {
+            if (other.slots[i].distance == 0) continue;
+            constructValue(slots[i], other.slots[i].value);
+            slots[i].distance = other.slots[i].distance;
+            slots[i].hash = other.slots[i].hash;
+        }
+        elements = other.elements;
+    }
+
+    void steal(flatHashTable& other) {
+        slots = other.slots;
+        buckets = other.buckets;
+        elements = other.elements;
+        shift = other.shift;
+        probeLimit = other.probeLimit;
+        other.slots = nullptr;
+        other.buckets = 0;
+        other.elements = 0;
+    }
+
+    template <typename... Args>
+    void constructValue(slot& s, Args&&... args) {
+        Allocator a(alloc);
+        valueTraits::construct(a, std::addressof(s.value), std::forward<Args>(args)...);
+    }
+
+    void destroyValue(slot& s) {
+        Allocator a(alloc);
+        valueTraits::destroy(a, std::addressof(s.value));
+    }
+
+    slotAllocator        alloc;
+    slot*                slots{nullptr};
+    size_type            buckets{0};                     // Number of slots keys hash to (power of 2)
+    size_type            elements{0};               // Number of elements
+    int                  shift{64};
+    std::uint32_t        probeLimit{0};                  // Largest distance
+};
+
+template <typename Key, typename Value>
+struct flatHashMapKey {
+    const Key&           operator()             (const std::pair<Key, Value>& v) const { return v.first; }
+};
+
+template <typename Key>
+struct flatHashSetKey {
+    const Key&           operator()             (const Key& v) const { return v; }
+};
+
+// Open addressing replacement for std::unordered_map
+// Elements are std::pair<Key, Value> (the key is not const, since elements are moved between slots)
+//
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<Key, Value>>>
+class flatHashMap : public flatHashTable<std::pair<Key, Value>, Key, flatHashMapKey<Key, Value>, Hash, KeyEqual, Allocator> {
+    using table = flatHashTable<std::pair<Key, Value>, Key, flatHashMapKey<Key, Value>, Hash, KeyEqual, Allocator>;
+public:
+    using mapped_type    = Value;
+    using typename table::iterator;
+    using table::table;
+    using table::insert;
+
+                         flatHashMap            () = default;
+                         flatHashMap            (std::initializer_list<std::pair<Key, Value>> list) { insert(list.begin(), list.end()); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return this->emplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    Value&               operator[]             (const Key& key) { return try_emplace(key).first->second; }
+};
+
+// Open addressing replacement for std::unordered_set
+//
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class flatHashSet : public flatHashTable<Key, Key, flatHashSetKey<Key>, Hash, KeyEqual, Allocator> {
+    using table = flatHashTable<Key, Key, flatHashSetKey<Key>, Hash, KeyEqual, Allocator>;
+public:
+    using table::table;
+    using table::insert;
+
+                         flatHashSet            () = default;
+                         flatHashSet            (std::initializer_list<Key> list) { insert(list.begin(), list.end()); }
+};
+
+// Hash of strings that can be used to look up std::string keys with a std::string_view or a const char*
+//  without creating a std::string
+//
+struct stringHash {
+    using is_transparent = void;
+    std::size_t          operator()             (std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+template <typename Value>
+using flatStringMap = flatHashMap<std::string, Value, stringHash, std::equal_to<>>;
+
+#endif
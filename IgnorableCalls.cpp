@@ -14,9 +14,12 @@ extern std::vector<std::string> LANGUAGE;
 // Checks if 'call' is ignored
 // User-defined calls are checked for all languages
 //
-bool ignorableCalls::isIgnored(const std::string& call, const std::string& unitLanguage) {
-return (ignoredCalls.at(unitLanguage).find(call) != ignoredCalls.at(unitLanguage).end()) || 
-       (userIgnoredCalls.find(call) != userIgnoredCalls.end());
+bool ignorableCalls::isIgnored(const std::string& call, const std::string& unitLanguage) const {
+    return getMatcher(unitLanguage).isIgnored(call);
+}
+
+const ignoredCallMatcher& ignorableCalls::getMatcher(const std::string& unitLanguage) const {
+    return matchers.at(unitLanguage);
 }
 
 // Reads a set of user-defined calls to ignore 
@@ -33,6 +36,8 @@ std::istream& operator>>(std::istream& in, ignorableCalls& calls)  {
 //
 void ignorableCalls::addCall(const std::string& ignoredCall) {
     userIgnoredCalls.insert(ignoredCall);
+    for (auto& pair : matchers)
+        pair.second.addCall(ignoredCall);
 }
 
 void ignorableCalls::outputCalls() {
@@ -80,5 +85,83 @@ void ignorableCalls::createCallList() {
                 "exit"
             }});
         }
-    }   
+    }
+
+    for (const auto& pair : ignoredCalls) {
+        ignoredCallMatcher& matcher = matchers[pair.first];
+        for (const std::string& call : pair.second)
+            matcher.addCall(call);
+        for (const std::string& call : userIgnoredCalls)
+            matcher.addCall(call);
+    }
+}
+
+ignoredCallMatcher::ignoredCallMatcher() {
+    rootNext.fill(-1);
+    next.emplace_back();
+    terminal.push_back(0);
+}
+
+// Adds a call to ignore
+// A trailing '*' makes the call a prefix
+//
+void ignoredCallMatcher::addCall(const std::string& call) {
+    std::string_view literal = call;
+    bool isPrefix = !literal.empty() && literal.back() == '*';
+    if (isPrefix) literal.remove_suffix(1);
+    if (literal.empty() && !isPrefix) return;
+
+    int node = 0;
+    for (char c : literal) {
+        int child = findNext(node, c);
+        if (child < 0) {
+            child = next.size();
+            next.emplace_back();
+            terminal.push_back(0);
+            if (node == 0) rootNext[static_cast<unsigned char>(c)] = child;
+            else next[node].push_back({c, child});
+        }
+        node = child;
+    }
+    if (isPrefix) terminal[node] = 2;
+    else if (terminal[node] == 0) terminal[node] = 1;
+}
+
+int ignoredCallMatcher::findNext(int node, char c) const {
+    if (node == 0) return rootNext[static_cast<unsigned char>(c)];
+    for (const auto& child : next[node])
+        if (child.first == c) return child.second;
+    return -1;
+}
+
+// Checks if 'name' is a call or starts with a prefix of calls
+//
+bool ignoredCallMatcher::matches(std::string_view name) const {
+    int node = 0;
+    for (char c : name) {
+        if (terminal[node] == 2) return true;
+        node = findNext(node, c);
+        if (node < 0) return false;
+    }
+    return terminal[node] != 0;
+}
+
+// Checks if a call is ignored
+// Generics are removed, then the whole call name (e.g., std::exit) 
+//  and its last part (e.g., exit) are matched
+//
+bool ignoredCallMatcher::isIgnored(std::string_view callName) const {
+    callName = callName.substr(0, callName.find('<'));
+    if (matches(callName)) return true;
+
+    std::size_t split = callName.rfind("::");
+    if (split != std::string_view::npos)
+        return matches(callName.substr(split + 2));
+    split = callName.rfind("->");
+    if (split != std::string_view::npos)
+        return matches(callName.substr(split + 2));
+    split = callName.rfind('.');
+    if (split != std::string_view::npos)
+        return matches(callName.substr(split + 1));
+    return false;
 }
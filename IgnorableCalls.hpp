@@ -16,10 +16,33 @@
 #include <unordered_map>
 #include <vector>
 #include <iostream>
+#include <array>
+#include <string_view>
+
+// Matches call names against the calls to ignore
+// Calls are stored in a trie. A call ending with '*' matches any name that starts with it
+//  (e.g., Log* or a namespace wildcard such as logging::*)
+//
+class ignoredCallMatcher {
+public:
+                         ignoredCallMatcher       ();
+
+    void                 addCall                  (const std::string&);
+    bool                 isIgnored                (std::string_view) const;
+
+private:
+    bool                 matches                  (std::string_view) const;
+    int                  findNext                 (int, char) const;
+
+    std::array<int, 256>                            rootNext;            // Child of the root for each character (-1 if none)
+    std::vector<std::vector<std::pair<char, int>>>  next;                // Children of each node
+    std::vector<char>                               terminal;            // 0 = not a call, 1 = call, 2 = prefix of calls (ends with '*')
+};
 
 class ignorableCalls {
 public:
-    bool                 isIgnored                (const std::string&, const std::string&);
+    bool                 isIgnored                (const std::string&, const std::string&) const;
+    const ignoredCallMatcher& getMatcher          (const std::string&) const;
     void                 addCall                  (const std::string&);
     void                 createCallList           ();
     void                 outputCalls              ();
@@ -28,6 +51,7 @@ public:
 private:
     std::unordered_map<std::string, std::unordered_set<std::string>>       ignoredCalls;        // List of calls to ignore
     std::unordered_set<std::string>                                        userIgnoredCalls;    // List of user-defined calls to ignore 
+    std::unordered_map<std::string, ignoredCallMatcher>                    matchers;            // Compiled calls to ignore per language
 };
 
 #endif
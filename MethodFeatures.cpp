@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file MethodFeatures.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "MethodFeatures.hpp"
+
+// Adds a row for a method of a class (or a free function if id is -1)
+// className is the class name without whitespaces, namespaces, and generic types <> (empty for free functions)
+//
+void methodFeatures::addMethod(const methodModel& m, int id, const std::string& className, const std::string& unitLanguage) {
+    const std::string& returnTypeParsed = m.getReturnTypeParsed();
+
+    bool isBool = false;
+    bool isVoidOrEmpty = false;
+    if (unitLanguage == "C++") {
+        isBool = returnTypeParsed == "bool";
+        isVoidOrEmpty = returnTypeParsed == "void" || returnTypeParsed == "";
+    }
+    else if (unitLanguage == "C#") {
+        isBool = returnTypeParsed == "bool" || returnTypeParsed == "Boolean";
+        isVoidOrEmpty = returnTypeParsed == "void" || returnTypeParsed == "Void" || returnTypeParsed == "";
+    }
+    else if (unitLanguage == "Java") {
+        isBool = returnTypeParsed == "boolean";
+        isVoidOrEmpty = returnTypeParsed == "void" || returnTypeParsed == "Void" || returnTypeParsed == "";
+    }
+
+    bool isConstructorDestructor = m.IsConstructorDestructorUsed();
+
+    classId.push_back(id);
+    constructorDestructor.push_back(isConstructorDestructor);
+    destructor.push_back(m.IsDestructor());
+    copyConstructor.push_back(isConstructorDestructor && m.getParametersList().find(className) != std::string::npos);
+    mainFunction.push_back(m.getName() == "main" || m.getName() == "Main");
+    returnBool.push_back(isBool);
+    returnVoidOrEmpty.push_back(isVoidOrEmpty);
+    returnVoid.push_back(returnTypeParsed == "void");
+    returnVoidKeyword.push_back(returnTypeParsed == "void" || returnTypeParsed == "Void");
+    voidPointer.push_back(unitLanguage != "Java" && m.getReturnType().find("void*") != std::string::npos);
+    constMethod.push_back(m.IsConstMethod());
+    empty.push_back(m.IsEmpty());
+    factory.push_back(m.IsFactory() || m.IsStrictFactory());
+    strictFactory.push_back(m.IsStrictFactory());
+    attributeReturned.push_back(m.IsAttributeReturned());
+    attributeNotReturned.push_back(m.IsAttributeNotReturned());
+    parameterNotReturned.push_back(m.IsParameterNotReturned());
+    attributeUsed.push_back(m.IsAttributeUsed());
+    parameterUsed.push_back(m.IsParameterUsed());
+    parameterRefChanged.push_back(m.IsParameterRefChanged());
+    globalOrStaticChanged.push_back(m.IsGlobalOrStaticChanged());
+    nonPrimitiveLocalOrParameterChanged.push_back(m.IsNonPrimitiveLocalOrParameterChanged());
+    nonPrimitiveAttributeExternal.push_back(m.IsNonPrimitiveAttributeExternal());
+    nonPrimitiveLocalExternal.push_back(m.IsNonPrimitiveLocalExternal());
+    nonPrimitiveParameterExternal.push_back(m.IsNonPrimitiveParamaterExternal());
+    nonPrimitiveReturnTypeExternal.push_back(m.IsNonPrimitiveReturnTypeExternal());
+    numOfAttributesModified.push_back(m.getNumOfAttributesModified());
+    numOfFunctionCalls.push_back(m.getNumOfFunctionCalls());
+    numOfMethodCalls.push_back(m.getNumOfMethodCalls());
+    numOfConstructorCalls.push_back(m.getNumOfConstructorCalls());
+    numOfExternalFunctionCalls.push_back(m.getNumOfExternalFunctionCalls());
+    numOfExternalMethodCalls.push_back(m.getNumOfExternalMethodCalls());
+}
+
+// Returns the first row of a class (or size() if the class has no rows)
+//
+std::size_t methodFeatures::findFirstRow(int id) const {
+    return std::lower_bound(classId.begin(), classId.end(), id) - classId.begin();
+}
+
+// Applies the method stereotype rules to all rows and sets the stereotype column
+// Rules are evaluated without branches on blocks of rows, so the compiler can vectorize the loop
+//  (SSE2 on any x86-64 build, AVX2 when built for a CPU that has it). Results are first written to a
+//  local block, which cannot alias the feature columns
+// GCC vectorizes this loop at -O3 (the Release build type set in CMakeLists.txt), not at -O2: its -O2
+//  cost model rejects loops with a variable trip count
+//
+void methodFeatures::classifyMethods() {
+    const std::size_t BLOCK_SIZE = 64;
+    std::uint32_t block[BLOCK_SIZE];
+
+    stereotype.resize(size());
+    for (std::size_t first = 0; first < size(); first += BLOCK_SIZE) {
+        std::size_t count = std::min(BLOCK_SIZE, size() - first);
+        for (std::size_t j = 0; j < count; ++j) {
+            std::size_t row = first + j;
+            std::uint32_t cd = constructorDestructor[row];
+            std::uint32_t nc = cd ^ 1;
+            int attributesModified = numOfAttributesModified[row];
+            int functionCalls = numOfFunctionCalls[row];
+            int methodCalls = numOfMethodCalls[row];
+            int constructorCalls = numOfConstructorCalls[row];
+            int externalFunctionCalls = numOfExternalFunctionCalls[row];
+            int externalMethodCalls = numOfExternalMethodCalls[row];
+
+            // Stereotype constructor copy-constructor destructor:
+            block[j] = (cd & destructor[row]) << STEREOTYPE_DESTRUCTOR |
+                       (cd & (destructor[row] ^ 1) & copyConstructor[row]) << STEREOTYPE_COPY_CONSTRUCTOR |
+                       (cd & (destructor[row] ^ 1) & (copyConstructor[row] ^ 1)) << STEREOTYPE_CONSTRUCTOR;
+
+            // Stereotype get:
+            // 1] Return type is not void
+            // 2] Contains at least one simple return expression that returns an attribute (e.g., return dm;)
+            // "this" keyword by itself is not considered (e.g., return this;)
+            block[j] |= (nc & attributeReturned[row]) << STEREOTYPE_GET;
+
+            // Stereotype predicate:
+            // 1] Return type is Boolean
+            // 2] Contains at least one complex return expression
+            // 3] Uses a data member in an expression or has at least
+            //     one function call to other methods in class
+            //
+            // Constructor calls are not considered
+            // Ignored calls are not considered
+            // "this" keyword by itself is considered
+            std::uint32_t attributeUsedOrCalls = attributeUsed[row] | (functionCalls > 0);
+            block[j] |= (nc & returnBool[row] & attributeNotReturned[row] & attributeUsedOrCalls) << STEREOTYPE_PREDICATE;
+
+            // Stereotype property:
+            // 1] Return type is not void or Boolean
+            // 2] Contains at least one complex return statement (e.g., return a+5;)
+            // 3] Uses a data member in an expression or has at least
+            //     one function call to other methods in class
+            //
+            // Constructor calls are not considered
+            // Ignored calls are not considered
+            // "this" keyword by itself is considered
+            std::uint32_t returnNotVoidOrBool = ((returnBool[row] ^ 1) & (returnVoidOrEmpty[row] ^ 1)) | voidPointer[row];
+            block[j] |= (nc & (strictFactory[row] ^ 1) & returnNotVoidOrBool & attributeNotReturned[row] & attributeUsedOrCalls) << STEREOTYPE_PROPERTY;
+
+            // Stereotype void-accessor:
+            // 1] Return type is void
+            // 2] Contains at least one parameter that is passed by non-const reference and is assigned a value
+            // 3] Uses a data member in an expression or has at least
+            //     one function call to other methods in class
+            //
+            // Constructor calls are not considered
+            // Ignored calls are not considered
+            // "this" keyword by itself is considered
+            block[j] |= (nc & parameterRefChanged[row] & returnVoid[row] & (voidPointer[row] ^ 1) & attributeUsedOrCalls) << STEREOTYPE_VOID_ACCESSOR;
+
+            // Stereotype set:
+            // 1] Only one data member is changed
+            // 2] Number of calls on data members or to methods in class is at most 1
+            //
+            // Constructor calls are not considered
+            // Ignored calls are not considered
+            // "this" keyword by itself is considered
+            block[j] |= (nc & (attributesModified == 1) & (functionCalls + methodCalls <= 1)) << STEREOTYPE_SET;
+
+            // stereotype command:
+            //     Method has a void return type
+            //     Cases:
+            //          Case 1: More than one data member is modifed
+            //          Case 2: one data member is modifed and:
+            //                  -	There is at least two calls on data members or
+            //                      function calls to other methods in class
+            //          Case 3: zero data members modifed and:
+            //                  -	there is at least one call on a data member
+            //                      or one function call to other methods in clasa
+            //     Method is not const (C++ only)
+            //     Case 1 applies when attributes are mutable and method is const (C++ only)
+            //
+            //    Constructor calls are not considered
+            //    Ignored calls are not considered
+            //    "this" keyword by itself is considered
+            //
+            // stereotype non-void-command (C++ only):
+            //    Method return type is not void
+            std::uint32_t case1 = (attributesModified == 0) & ((functionCalls > 0) | (methodCalls > 0));
+            std::uint32_t case2 = (attributesModified == 1) & (methodCalls + functionCalls > 1);
+            std::uint32_t case3 = attributesModified > 1;
+            std::uint32_t mutableCase = constMethod[row] & case3;  // Handles case of mutable attributes (C++ only)
+            std::uint32_t command = nc & (case1 | case2 | case3) & ((constMethod[row] ^ 1) | mutableCase);
+            std::uint32_t returnCheck = (returnVoidKeyword[row] ^ 1) & (voidPointer[row] ^ 1);
+            block[j] |= (command & returnCheck) << STEREOTYPE_NON_VOID_COMMAND |
+                        (command & (returnCheck ^ 1)) << STEREOTYPE_COMMAND;
+
+            // Stereotype factory
+            // 1] Factories must include a non-primitive type in their return type
+            //      and their return expression must be a local variable, parameter, or attribute, that
+            //      call a constructor call or has a return expression with a constructor call (e.g., new)
+            //
+            // Variables created with ignored calls are considered
+            // Returns that have "new" ignored calls are also considered
+            // "this" keyword by itself is not considered
+            block[j] |= std::uint32_t(factory[row]) << STEREOTYPE_FACTORY;
+
+            // Stereotype wrapper:
+            // 1] No data members are modified
+            // 2] No calls to methods in class
+            // 3] No calls on data members
+            // 4] Has at least one free function call
+            // Constructor calls are not considered
+            //
+            // Stereotype controller:
+            // 1] No data members are modified
+            // 2] No calls to methods in class
+            // 3] No calls on data members
+            // 3] Has at least one call to other class methods or mutates a parameter or a local that is non-primitive
+            //
+            // Stereotype collaborator:
+            // 1] It must use at least 1 non-primitive type (not of this class)
+            // 2] Type could be a parameter, local variable, return type, or an attribute
+            //
+            // Ignored calls are not considered
+            // "this" keyword by itself is considered only for wrapper and controller
+            std::uint32_t notEmpty = nc & (empty[row] ^ 1);
+            std::uint32_t noStateChangeOrUse = (attributesModified == 0) & (functionCalls == 0) & (methodCalls == 0);
+            std::uint32_t wrapper = notEmpty & noStateChangeOrUse & (externalMethodCalls == 0) & (externalFunctionCalls > 0);
+            std::uint32_t controller = notEmpty & (wrapper ^ 1) & noStateChangeOrUse & 
+                                       ((externalMethodCalls > 0) | nonPrimitiveLocalOrParameterChanged[row]);
+            std::uint32_t nonPrimitiveExternal = nonPrimitiveAttributeExternal[row] | nonPrimitiveLocalExternal[row] | 
+                                                 nonPrimitiveParameterExternal[row] | nonPrimitiveReturnTypeExternal[row] | voidPointer[row];
+            block[j] |= wrapper << STEREOTYPE_WRAPPER | controller << STEREOTYPE_CONTROLLER |
+                        (notEmpty & (wrapper ^ 1) & (controller ^ 1) & nonPrimitiveExternal) << STEREOTYPE_COLLABORATOR;
+
+            // Stereotype incidental
+            // 1] Method contains at least one non-comment statement (i.e., method is not empty)
+            // 2] No data members are used or modified (including no use of keyword "this" by itself)
+            // 3] No calls of any kind
+            // Ignored calls are allowed
+            std::uint32_t noCallsInClass = (functionCalls == 0) & (methodCalls == 0);
+            std::uint32_t noCalls = noCallsInClass & (constructorCalls == 0) & (externalMethodCalls == 0) & (externalFunctionCalls == 0);
+            block[j] |= (notEmpty & (attributeUsed[row] ^ 1) & noCalls) << STEREOTYPE_INCIDENTAL;
+
+            // Stereotype stateless
+            // 1]	Method contains at least one non-comment statement (i.e., method is not empty)
+            // 2]	No data members are used or modified (including no use of keyword "this" by itself)
+            // 3]	No calls to methods in class
+            // 4]   No calls on data members
+            // 5]   Has at least one call to other class methods (including constructor calls) or to a free function
+            // Ignored calls are not considered
+            std::uint32_t otherCalls = (externalFunctionCalls > 0) | (externalMethodCalls > 0) | (constructorCalls > 0);
+            block[j] |= (notEmpty & (attributeUsed[row] ^ 1) & noCallsInClass & otherCalls) << STEREOTYPE_STATELESS;
+
+            // Stereotype empty
+            // 1] Method has no statements except for comments
+            block[j] |= (nc & empty[row]) << STEREOTYPE_EMPTY;
+
+            block[j] |= std::uint32_t(block[j] == 0) << STEREOTYPE_UNCLASSIFIED;
+        }
+        std::copy(block, block + count, stereotype.begin() + first);
+    }
+}
+
+// Counts the stereotypes of count rows starting at first (constructors and destructors are not counted)
+// counts must have NUM_METHOD_STEREOTYPES elements. nonCollaborators is set to the number of
+//  methods that are not collaborators, controllers, or wrappers
+// The rows of a class are reduced one block at a time: the stereotype column is masked into a local
+//  block, then each stereotype is a separate sum over the whole block. The sums have a constant trip
+//  count and no dependency between rows, so GCC vectorizes them at -O2 as well as -O3 (the masking
+//  loop has a variable trip count and is vectorized at -O3 only, like classifyMethods)
+//
+void methodFeatures::countStereotypes(std::size_t first, std::size_t count, int* counts, int& nonCollaborators) const {
+    const std::uint32_t COLLABORATORS = 1u << STEREOTYPE_COLLABORATOR | 1u << STEREOTYPE_CONTROLLER | 1u << STEREOTYPE_WRAPPER;
+    const std::size_t BLOCK_SIZE = 64;
+    std::uint32_t block[BLOCK_SIZE];
+
+    int total[NUM_METHOD_STEREOTYPES] = {};
+    int collaborators = 0;
+    int constructorsDestructors = 0;
+    for (std::size_t offset = 0; offset < count; offset += BLOCK_SIZE) {
+        std::size_t rows = std::min(BLOCK_SIZE, count - offset);
+        const std::uint32_t* stereotypes = stereotype.data() + first + offset;
+        const std::uint8_t* constructors = constructorDestructor.data() + first + offset;
+
+        // Constructors and destructors are masked out. The unused part of the last block is zero
+        for (std::size_t j = 0; j < BLOCK_SIZE; ++j)
+            block[j] = 0;
+        for (std::size_t j = 0; j < rows; ++j) {
+            block[j] = stereotypes[j] & (std::uint32_t(constructors[j]) - 1);
+            constructorsDestructors += constructors[j];
+        }
+
+        for (int i = 0; i < NUM_METHOD_STEREOTYPES; ++i) {
+            int sum = 0;
+            for (std::size_t j = 0; j < BLOCK_SIZE; ++j)
+                sum += (block[j] >> i) & 1;
+            total[i] += sum;
+        }
+        for (std::size_t j = 0; j < BLOCK_SIZE; ++j)
+            collaborators += (block[j] & COLLABORATORS) != 0;
+    }
+
+    std::copy(total, total + NUM_METHOD_STEREOTYPES, counts);
+    nonCollaborators = count - constructorsDestructors - collaborators;
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file MethodFeatures.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef METHODFEATURES_HPP
+#define METHODFEATURES_HPP
+
+#include <vector>
+#include <cstdint>
+#include "MethodModel.hpp"
+#include "Stereotype.hpp"
+
+// Features of methods used by the stereotype rules
+// Stored as a table with one column per feature and one row per method (struct of arrays),
+//  so a rule only reads the columns it needs instead of whole method models
+// Rows of a class are contiguous and sorted by class id
+// Return type checks that depend on the language are computed once when a row is added
+//
+class methodFeatures {
+public:
+    void                        addMethod                (const methodModel&, int, const std::string&, const std::string&);
+    std::size_t                 size                     () const       { return classId.size(); }
+    std::size_t                 findFirstRow             (int) const;
+    void                        classifyMethods          ();
+    void                        countStereotypes         (std::size_t, std::size_t, int*, int&) const;
+
+    std::vector<int>            classId;                               // Class of the method (-1 for free functions)
+    std::vector<std::uint8_t>   constructorDestructor;                 // Method is a constructor or a destructor
+    std::vector<std::uint8_t>   destructor;                            // Method is a destructor
+    std::vector<std::uint8_t>   copyConstructor;                       // Constructor whose parameters use the class name
+    std::vector<std::uint8_t>   mainFunction;                          // Method is named main or Main
+    std::vector<std::uint8_t>   returnBool;                            // Return type is Boolean
+    std::vector<std::uint8_t>   returnVoidOrEmpty;                     // Return type is void or there is no return type
+    std::vector<std::uint8_t>   returnVoid;                            // Return type is exactly "void"
+    std::vector<std::uint8_t>   returnVoidKeyword;                     // Return type is "void" or "Void"
+    std::vector<std::uint8_t>   voidPointer;                           // Return type contains void* (not in Java)
+    std::vector<std::uint8_t>   constMethod;
+    std::vector<std::uint8_t>   empty;
+    std::vector<std::uint8_t>   factory;                               // Method is a factory or a strict factory
+    std::vector<std::uint8_t>   strictFactory;
+    std::vector<std::uint8_t>   attributeReturned;
+    std::vector<std::uint8_t>   attributeNotReturned;
+    std::vector<std::uint8_t>   parameterNotReturned;
+    std::vector<std::uint8_t>   attributeUsed;
+    std::vector<std::uint8_t>   parameterUsed;
+    std::vector<std::uint8_t>   parameterRefChanged;
+    std::vector<std::uint8_t>   globalOrStaticChanged;
+    std::vector<std::uint8_t>   nonPrimitiveLocalOrParameterChanged;
+    std::vector<std::uint8_t>   nonPrimitiveAttributeExternal;
+    std::vector<std::uint8_t>   nonPrimitiveLocalExternal;
+    std::vector<std::uint8_t>   nonPrimitiveParameterExternal;
+    std::vector<std::uint8_t>   nonPrimitiveReturnTypeExternal;
+    std::vector<int>            numOfAttributesModified;
+    std::vector<int>            numOfFunctionCalls;
+    std::vector<int>            numOfMethodCalls;
+    std::vector<int>            numOfConstructorCalls;
+    std::vector<int>            numOfExternalFunctionCalls;
+    std::vector<int>            numOfExternalMethodCalls;
+
+    std::vector<std::uint32_t>  stereotype;                            // Stereotypes of the method (one bit per stereotype) set by classifyMethods()
+};
+
+#endif
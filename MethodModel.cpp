@@ -16,9 +16,15 @@ extern XPathBuilder      XPATH_TRANSFORMATION;
 methodModel::methodModel(srcml_archive* archive, srcml_unit* unit, const std::string& methodXpath, 
                          const std::string& unitLang, const std::string& propertyReturnType, int unitNum) :
                          unitLanguage(unitLang),  xpath(methodXpath), unitNumber(unitNum) {
-    srcML = srcml_unit_get_srcml(unit);
+    const char* unitSrcML = srcml_unit_get_srcml(unit);
 
     isConstructorDestructor(archive, unit);
+
+    // Constructors and destructors are not analyzed, so their srcML is not kept
+    if (constructorDestructorUsed)
+        destructor = std::string_view(unitSrcML).find("<destructor>") != std::string_view::npos;
+    else
+        srcML = compressedText(unitSrcML);
     findMethodName(archive, unit); 
     findParameterList(archive, unit);
 
@@ -29,22 +35,69 @@ methodModel::methodModel(srcml_archive* archive, srcml_unit* unit, const std::st
     returnType = propertyReturnType; 
     
     // Name signature needed for call analysis
-    std::string paramList = parametersList;
-    std::string methName = name;
-    removeBetweenComma(paramList, false);
-    removeNamespace(methName, true, unitLanguage);
-    nameSignature = methName + paramList;
-    trimWhitespace(nameSignature);
-}
-
-void methodModel::findMethodData(std::unordered_map<std::string, variable>& attributes, 
-                                 const std::unordered_set<std::string>& classMethods, 
-                                 const std::unordered_set<std::string>& inheritedClassMethods,
-                                 const std::string& classNamePar) {
+    std::string_view methName = removeNamespace(std::string_view(name), true, unitLanguage);
+    std::string signature(methName.size() + parametersList.size(), ' ');
+    methName.copy(signature.data(), methName.size());
+    signature.resize(methName.size() + removeBetweenComma(parametersList, false, signature.data() + methName.size()));
+    trimWhitespace(signature);
+    nameSignature = SYMBOLS.intern(signature);
+}
+
+// Destroys a container and constructs it again (empty) with another memory resource
+// Assigning does not work since pmr containers keep their memory resource
+//
+template <typename T>
+static void recreate(T& container, std::pmr::memory_resource* resource) {
+    container.~T();
+    new (&container) T(resource);
+}
+
+// Makes the transient facts of the method (parameters, locals, calls, and return expressions) allocate from resource
+// Facts are collected again by findMethodData() or findFreeFunctionData(), so nothing is lost
+//
+void methodModel::useMemoryResource(std::pmr::memory_resource* resource) {
+    recreate(parametersOrdered, resource);
+    recreate(localsOrdered, resource);
+    recreate(parameters, resource);
+    recreate(locals, resource);
+    recreate(variablesCreatedWithNew, resource);
+    recreate(functionCalls, resource);
+    recreate(methodCalls, resource);
+    recreate(constructorCalls, resource);
+    recreate(returnExpressions, resource);
+}
+
+// Condenses the transient facts into the counts used by the stereotype rules and
+//  drops them, so the arena they were allocated from can be released
+// The srcML of the method is also dropped since the method is not analyzed again
+//
+void methodModel::releaseMethodData() {
+    numOfFunctionCalls = functionCalls.size();
+    numOfMethodCalls = methodCalls.size();
+    numOfConstructorCalls = constructorCalls.size();
+
+    scope.clear();
+    inheritedAttributes = nullptr;
+    useMemoryResource(std::pmr::get_default_resource());
+    srcML.release();
+}
+
+// Analyzes the method
+// Transient facts are allocated from resource (an arena shared by the methods of the class) and
+//  released before returning. Their names are local symbols that are dropped with them
+//
+void methodModel::findMethodData(variableMap& attributes, const std::vector<attributeLayer>& inheritedClassAttributes,
+                                 const symbolSet& classMethods,
+                                 const std::string& classNamePar, std::pmr::memory_resource* resource) {
+    localSymbolTable localSymbols(resource);
     classNameParsed = classNamePar;
+    scope.clear();
+    inheritedAttributes = &inheritedClassAttributes;
+    useMemoryResource(resource);
     if (!constructorDestructorUsed) {                                
+        std::string methodSrcML = srcML.decompress();
         srcml_archive* archive = srcml_archive_create();
-        srcml_archive_read_open_memory(archive, srcML.c_str(), srcML.size());
+        srcml_archive_read_open_memory(archive, methodSrcML.c_str(), methodSrcML.size());
         srcml_unit* unit = srcml_archive_read_unit(archive);
 
         findMethodReturnType(archive, unit); 
@@ -64,7 +117,7 @@ void methodModel::findMethodData(std::unordered_map<std::string, variable>& attr
         isIgnorableCall(constructorCalls);
 
         // Must only be called after isIgnorableCall()
-        isCallOnAttribute(attributes, classMethods, inheritedClassMethods);
+        isCallOnAttribute(attributes, classMethods);
     
         // Must only be called after findNewAssign()
         isVariableReturned(attributes, false); 
@@ -79,12 +132,21 @@ void methodModel::findMethodData(std::unordered_map<std::string, variable>& attr
         srcml_archive_close(archive);
         srcml_archive_free(archive); 
     }
+    releaseMethodData();
 }
 
-void methodModel::findFreeFunctionData() {
+// Analyzes the free function
+// Transient facts are allocated from resource (an arena shared by the free functions of the unit) and
+//  released before returning. Their names are local symbols that are dropped with them
+//
+void methodModel::findFreeFunctionData(std::pmr::memory_resource* resource) {
+    localSymbolTable localSymbols(resource);
+    scope.clear();
+    useMemoryResource(resource);
     if (!constructorDestructorUsed) {
+        std::string methodSrcML = srcML.decompress();
         srcml_archive* archive = srcml_archive_create();
-        srcml_archive_read_open_memory(archive, srcML.c_str(), srcML.size());
+        srcml_archive_read_open_memory(archive, methodSrcML.c_str(), methodSrcML.size());
         srcml_unit* unit = srcml_archive_read_unit(archive);
 
         findMethodReturnType(archive, unit); 
@@ -112,6 +174,7 @@ void methodModel::findFreeFunctionData() {
         srcml_archive_close(archive);
         srcml_archive_free(archive); 
     }
+    releaseMethodData();
 }
 
 // Gets the method name
@@ -211,19 +274,17 @@ void methodModel::findLocalVariableName(srcml_archive* archive, srcml_unit* unit
         std::size_t size = 0;
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
     
-        std::string localName = unparsed;
+        std::string_view localName = unparsed;
 
-        // Chop off [] for arrays  
+        // Chop off [] for arrays
         if (unitLanguage == "C++") {
             std::size_t start_position = localName.find("[");
-            if (start_position != std::string::npos){
-                localName = localName.substr(0, start_position);
-                Rtrim(localName);
-            }
+            if (start_position != std::string_view::npos)
+                localName = Rtrim(localName.substr(0, start_position));
         }
         
         localsOrdered.push_back(variable());
-        localsOrdered.back().setName(localName);
+        localsOrdered.back().setName(SYMBOLS.internLocal(localName));
         
         free(unparsed);
     }
@@ -238,6 +299,7 @@ void methodModel::findLocalVariableType(srcml_archive* archive, srcml_unit* unit
     srcml_transform_result* result = nullptr;
     srcml_unit_apply_transforms(archive, unit, &result);
     int n = srcml_transform_get_unit_size(result);
+    locals.reserve(n);
 
     srcml_unit* resultUnit = nullptr;
     std::string prev = "";
@@ -256,9 +318,9 @@ void methodModel::findLocalVariableType(srcml_archive* archive, srcml_unit* unit
             type = unparsed;
             prev = type;
         }  
-        localsOrdered[i].setType(type);
+        localsOrdered[i].setType(SYMBOLS.internLocal(type));
         isNonPrimitiveType(type, localsOrdered[i], unitLanguage, classNameParsed);
-        locals.insert({localsOrdered[i].getName(), localsOrdered[i]});
+        locals.insert({localsOrdered[i].getNameSymbol(), localsOrdered[i]});
         nonPrimitiveLocalExternal = localsOrdered[i].getNonPrimitiveExternal();
   
         free(unparsed);
@@ -283,19 +345,17 @@ void methodModel::findParameterName(srcml_archive* archive, srcml_unit* unit) {
         std::size_t size = 0;
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
 
-        std::string parameterName = unparsed;
+        std::string_view parameterName = unparsed;
 
         // Chop off [] for arrays
-        if (unitLanguage == "C++") {  
+        if (unitLanguage == "C++") {
             std::size_t start_position = parameterName.find("[");
-            if (start_position != std::string::npos){
-                parameterName = parameterName.substr(0, start_position);
-                Rtrim(parameterName);
-            }
+            if (start_position != std::string_view::npos)
+                parameterName = Rtrim(parameterName.substr(0, start_position));
         }
 
         parametersOrdered.push_back(variable());
-        parametersOrdered.back().setName(parameterName);
+        parametersOrdered.back().setName(SYMBOLS.internLocal(parameterName));
         parametersOrdered.back().setPos(i);
         
         free(unparsed);
@@ -314,6 +374,7 @@ void methodModel::findParameterType(srcml_archive* archive, srcml_unit* unit) {
     srcml_transform_result* result = nullptr;
     srcml_unit_apply_transforms(archive, unit, &result);
     int n = srcml_transform_get_unit_size(result);
+    parameters.reserve(n);
 
     srcml_unit* resultUnit = nullptr;
 
@@ -324,9 +385,9 @@ void methodModel::findParameterType(srcml_archive* archive, srcml_unit* unit) {
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
         std::string type = unparsed;
     
-        parametersOrdered[i].setType(type);
+        parametersOrdered[i].setType(SYMBOLS.internLocal(type));
         isNonPrimitiveType(type, parametersOrdered[i], unitLanguage, classNameParsed);
-        parameters.insert({parametersOrdered[i].getName(), parametersOrdered[i]});
+        parameters.insert({parametersOrdered[i].getNameSymbol(), parametersOrdered[i]});
         nonPrimitiveParamaterExternal = parametersOrdered[i].getNonPrimitiveExternal();
         free(unparsed);
     }
@@ -335,11 +396,6 @@ void methodModel::findParameterType(srcml_archive* archive, srcml_unit* unit) {
     srcml_transform_free(result);
 }
 
-
-
-
-
-
 // Collects all return expressions
 //
 void methodModel::findReturnExpression(srcml_archive* archive, srcml_unit* unit) {
@@ -358,7 +414,7 @@ void methodModel::findReturnExpression(srcml_archive* archive, srcml_unit* unit)
         std::string expr = unparsed;
         free(unparsed);
         
-        returnExpressions.push_back(expr);
+        returnExpressions.emplace_back(expr);
 
         std::string newOperator = expr.substr(0,3);
         if (newOperator == "new") 
@@ -394,7 +450,7 @@ void methodModel::findCallName(srcml_archive* archive, srcml_unit* unit) {
             srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
 
             calls call;
-            call.setName(unparsed);
+            call.setName(SYMBOLS.internLocal(unparsed));
             
             if (c == "function")  
                 functionCalls.push_back(call);
@@ -433,16 +489,16 @@ void methodModel::findCallArgument(srcml_archive* archive, srcml_unit* unit) {
             std::size_t size = 0;
             srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
             
-            std::string arguList = unparsed;
+            std::string_view arguList = unparsed;
 
             if (c == "function")  {
                 functionCalls[i].setArgumentList(arguList);
-                removeBetweenComma(arguList, false);
-                std::string funcCallName = functionCalls[i].getName();
-                removeNamespace(funcCallName, true, unitLanguage);
-                std::string funcCallParsed = funcCallName + arguList;
+                std::string_view funcCallName = removeNamespace(std::string_view(functionCalls[i].getName()), true, unitLanguage);
+                std::string funcCallParsed(funcCallName.size() + arguList.size(), ' ');
+                funcCallName.copy(funcCallParsed.data(), funcCallName.size());
+                funcCallParsed.resize(funcCallName.size() + removeBetweenComma(arguList, false, funcCallParsed.data() + funcCallName.size()));
                 trimWhitespace(funcCallParsed);   
-                functionCalls[i].setSignature(funcCallParsed);
+                functionCalls[i].setSignature(SYMBOLS.internLocal(funcCallParsed));
             }
                 
             else if (c == "method")  
@@ -479,7 +535,7 @@ void methodModel::findNewAssign(srcml_archive* archive, srcml_unit* unit) {
         free(unparsed);
         trimWhitespace(varName);
         
-        variablesCreatedWithNew.insert(varName);
+        variablesCreatedWithNew.insert(SYMBOLS.internLocal(varName));
     }
     srcml_clear_transforms(archive);
     srcml_transform_free(result);
@@ -545,7 +601,7 @@ void methodModel::isConstructorDestructor(srcml_archive* archive, srcml_unit* un
 // C++ can use *, [], or & to pass by reference
 // No need to check for 'const' since this function is only called when there is a modification to the parameter
 //
-void methodModel::isParameterRefChanged(std::string para, bool propertyCheck) {
+void methodModel::isParameterRefChanged(symbol para, bool propertyCheck) {
     std::string type = parameters[para].getType();
     if (unitLanguage == "C++" || unitLanguage == "C#"){
         // C# could use * in unsafe contexts
@@ -590,8 +646,8 @@ void methodModel::isParameterRefChanged(std::string para, bool propertyCheck) {
 // Both simple returns (e.g., return variable;) and 
 //  complex returns (e.g., return variable + 5; or e.g., return 5 + 5;) are found
 //
-void methodModel::isVariableReturned(std::unordered_map<std::string, variable>& variables, bool isParameterCheck) {
-    for (const std::string& expr : returnExpressions) {
+void methodModel::isVariableReturned(variableMap& variables, bool isParameterCheck) {
+    for (const std::pmr::string& expr : returnExpressions) {
         if (isParameterCheck) {
             if (!isVariableUsed(variables, nullptr, expr, true, false, false, isParameterCheck, false))
                 parameterNotReturned = true; // Complex return
@@ -609,7 +665,7 @@ void methodModel::isVariableReturned(std::unordered_map<std::string, variable>&
 // Determines if a variable (parameter or an attribute) is used in an expression
 //
 void methodModel::isVariableUsedInExpression(srcml_archive* archive, srcml_unit* unit, 
-                                                         std::unordered_map<std::string, variable>& variables, bool isParameterCheck)  {
+                                                         variableMap& variables, bool isParameterCheck)  {
 
     srcml_append_transform_xpath(archive, XPATH_TRANSFORMATION.getXpath(unitLanguage,"expression_name").c_str());
     srcml_transform_result* result = nullptr;
@@ -635,8 +691,8 @@ void methodModel::isVariableUsedInExpression(srcml_archive* archive, srcml_unit*
 // An attribute or a parameter that is changed multiple times should only be considered as 1 change
 //
 void methodModel::isVariableModified(srcml_archive* archive, srcml_unit* unit, 
-                                     std::unordered_map<std::string, variable>& variables, bool isParameterCheck) { 
-    std::unordered_set<std::string> checked; 
+                                     variableMap& variables, bool isParameterCheck) { 
+    symbolSet checked; 
 
     srcml_append_transform_xpath(archive, XPATH_TRANSFORMATION.getXpath(unitLanguage,"expression_assignment").c_str());
     srcml_transform_result* result = nullptr;
@@ -650,19 +706,17 @@ void methodModel::isVariableModified(srcml_archive* archive, srcml_unit* unit,
         char *unparsed = nullptr;
         std::size_t size = 0;
         srcml_unit_unparse_memory(resultUnit, &unparsed, &size);
-        std::string possibleVariable = unparsed;
-        free(unparsed);  
-        
         std::size_t oldSize = checked.size();
 
         if (isParameterCheck)
-            isVariableUsed(variables, nullptr, possibleVariable, false, true, false, true, false);
-        else if (isVariableUsed(variables, &checked, possibleVariable, false, true, true, false, false)) {
+            isVariableUsed(variables, nullptr, unparsed, false, true, false, true, false);
+        else if (isVariableUsed(variables, &checked, unparsed, false, true, true, false, false)) {
             if (checked.size() > oldSize) {
                 ++numOfAttributesModified;
                 oldSize = checked.size();
             }         
         }
+        free(unparsed);  
     }
 
     srcml_clear_transforms(archive);
@@ -673,38 +727,13 @@ void methodModel::isVariableModified(srcml_archive* archive, srcml_unit* unit,
 // Usage of attributes within these calls are not ignored
 // For example, if call to ignore is 'foo', 
 //  then some of the matched cases are foo<>() or bar::foo() or a->b.foo()
-void methodModel::isIgnorableCall(std::vector<calls>& calls) {
-    for (auto it = calls.begin(); it != calls.end();) {
-        std::string callName = it->getName();
-
-        std::size_t listOpen = callName.find("<");
-        if (listOpen != std::string::npos)
-            callName = callName.substr(0, listOpen);
-            
-        // Try to match the whole call
-        if (IGNORED_CALLS.isIgnored(callName, unitLanguage)) { 
-            it = calls.erase(it);
-        }
-        else {
-            std::size_t split = callName.rfind("::");
-            if (split != std::string::npos)
-                callName = callName.substr(split + 2);
-            else {
-                split = callName.rfind("->");
-                if (split != std::string::npos)
-                    callName = callName.substr(split + 2);
-                else {
-                    split = callName.rfind(".");
-                    if (split != std::string::npos)
-                        callName = callName.substr(split + 1);
-                }
-            }
- 
-            if (IGNORED_CALLS.isIgnored(callName, unitLanguage)) 
-                it = calls.erase(it);
-            else ++it;                      
-        }
-    }
+// The remaining calls keep their order
+//
+void methodModel::isIgnorableCall(std::pmr::vector<calls>& calls) {
+    const ignoredCallMatcher& matcher = IGNORED_CALLS.getMatcher(unitLanguage);
+    calls.erase(std::remove_if(calls.begin(), calls.end(), [&matcher](const class calls& call) {
+        return matcher.isIgnored(call.getName());
+    }), calls.end());
 }
 
 // Function calls: --> foo() bar::foo()
@@ -723,13 +752,11 @@ void methodModel::isIgnorableCall(std::vector<calls>& calls) {
 //  For example, this.methodName();
 //  So these should be also treated as function calls and not method calls
 //
-void methodModel::isCallOnAttribute(std::unordered_map<std::string, variable>& attributes, 
-                                   const std::unordered_set<std::string>& classMethods, 
-                                   const std::unordered_set<std::string>& inheritedClassMethods) {  
+void methodModel::isCallOnAttribute(variableMap& attributes, const symbolSet& classMethods) {  
     // Check on function calls (Should be done before checking on method calls)
+    // classMethods has the method signatures of the class and of all parent classes
     for (auto it = functionCalls.begin(); it != functionCalls.end();) {  
-        if (classMethods.find(it->getSignature()) == classMethods.end() && 
-            inheritedClassMethods.find(it->getSignature()) == inheritedClassMethods.end()) { 
+        if (classMethods.find(it->getSignatureSymbol()) == classMethods.end()) { 
             it = functionCalls.erase(it);
             ++numOfExternalFunctionCalls;    
         }
@@ -743,9 +770,9 @@ void methodModel::isCallOnAttribute(std::unordered_map<std::string, variable>& a
         if (!isVariableUsed(attributes, nullptr, it->getName(), false, false, false, false, false)) { // Checks if call is on attribute
             if (unitLanguage != "C++") {
                 // These should be function calls
-                if (unitLanguage == "C#" && (matchSubstring(it->getName(), "this") || matchSubstring(it->getName(), "base")))
+                if (unitLanguage == "C#" && matchWord(it->getName(), {"this", "base"}))
                     functionCalls.push_back(*it); 
-                else if (unitLanguage == "Java" && (matchSubstring(it->getName(), "this") || matchSubstring(it->getName(), "super")))
+                else if (unitLanguage == "Java" && matchWord(it->getName(), {"this", "super"}))
                     functionCalls.push_back(*it); 
 
                 // Could be a call on a local or a parameter
@@ -780,18 +807,23 @@ void methodModel::isCallOnParameter() {
 // Where 'a' is a variable and Foo is class itself if the variable is an attribute
 // Can match with complex uses of variables (e.g., this->a.b.c or a[]->b or (*a).b.c)
 //
-bool methodModel::isVariableUsed(std::unordered_map<std::string, variable>& variables, 
-                                       std::unordered_set<std::string>* attributesModified, 
-                                       const std::string& expression, bool returnCheck, 
+bool methodModel::isVariableUsed(variableMap& variables, 
+                                       symbolSet* attributesModified, 
+                                       std::string_view expression, bool returnCheck, 
                                        bool parameterModifiedCheck,  bool localModifiedCheck,
                                        bool isParamaterCheck, bool isLocalCheck) {
-    std::string expr = expression; 
-    trimWhitespace(expr);
+    // The expression is only copied when whitespace or ? (C#) has to be removed from it
+    thread_local std::string trimmedExpression;
+    thread_local std::string nullCheckedExpression;
+    std::string_view expr = expression;
+    if (std::any_of(expr.begin(), expr.end(), [](unsigned char c) { return std::isspace(c); })) {
+        trimmedExpression.assign(expr);
+        trimWhitespace(trimmedExpression);
+        expr = trimmedExpression;
+    }
                
     // Remove brakcets. For example, a [3]
-    std::size_t openingBracket = expr.find("["); 
-    if (openingBracket != std::string::npos)
-        expr = expr.substr(0, openingBracket); 
+    expr = expr.substr(0, expr.find("["));
     
     // Removing () and {} on the outside of expression
     // Might remove } and ) for calls but that doesn't affect the analysis
@@ -799,93 +831,79 @@ bool methodModel::isVariableUsed(std::unordered_map<std::string, variable>& vari
         while (!expr.empty() && (expr.front() == '{' || expr.front() == '(')) { 
             if (expr.size() > 6 && expr.substr(1, 5) == "(*this)")
                 break;
-            expr.erase(0, 1);
+            expr.remove_prefix(1);
         }
-        while (!expr.empty() && (expr.back() == '}' || expr.back() == ')')) expr.pop_back();  
+        while (!expr.empty() && (expr.back() == '}' || expr.back() == ')')) expr.remove_suffix(1);  
     }
     else {
-        while (!expr.empty() && expr.front() == '(') expr.erase(0, 1);       
-        while (!expr.empty() && expr.back() == ')') expr.pop_back();       
+        while (!expr.empty() && expr.front() == '(') expr.remove_prefix(1);       
+        while (!expr.empty() && expr.back() == ')') expr.remove_suffix(1);       
     }
 
     // In C# the null-coalescing  operator is represented by ? or ?? and it allows you to check if an object 
     //  is null before accessing its members or using its value. For example, testString?.Length; or userInput ?? "Default Name"; 
-    if (unitLanguage == "C#") {
-        std::size_t nullCoalescingOperator = expr.find("?"); 
-        while (nullCoalescingOperator != std::string::npos) {
-            expr.erase(nullCoalescingOperator, 1); 
-            nullCoalescingOperator = expr.find("?"); // For chaining
-        }         
+    if (unitLanguage == "C#" && expr.find("?") != std::string_view::npos) {
+        nullCheckedExpression.clear();
+        std::remove_copy(expr.begin(), expr.end(), std::back_inserter(nullCheckedExpression), '?');
+        expr = nullCheckedExpression;
     }
 
     // Remove pointers. For example, *a
     if (unitLanguage != "Java") 
-        while (!expr.empty() && expr.front() == '*') expr.erase(0, 1);       
+        while (!expr.empty() && expr.front() == '*') expr.remove_prefix(1);       
     
     if (expr.empty()) return false;  
 
-    // ^ indicates that we should only match from the beginning
+    // Only the start of the expression is matched
     // We only care about the first two variables. For example, in a.b.c() the a.b is sufficient to 
     //  determine what "a" is
     // base and super point to the parent class (not interfaces)
-    bool isMatched = false;
-    std::smatch match;
-    std::string pattern;
-    if (!returnCheck) {
-        if (unitLanguage == "C++") 
-            pattern = R"(^(?:\(\*this\)\.|this->|([^.->]*)(?:::|\.|->))([^.->]*))";
-        else if (unitLanguage == "Java")
-            pattern = R"(^(?:super|this|([^.]*))\.([^.]*))";
-        else if (unitLanguage == "C#")
-            pattern = R"(^(?:base|this|([^.->]*))(?:\.|->)([^.->]*))";
-    }
-    else {
-        // $ Used to match end of line. For example, return this.a; matches but return this.a.b; doesn't
-        if (unitLanguage == "C++") 
-            pattern = R"(^(?:\(\*this\)\.|this->|([^.->]*)(?:::|\.|->))([^.->\(\){}]*)$)";
-        else if (unitLanguage == "Java")
-            pattern = R"(^(?:super|this|([^.]*))\.([^.\(\)]*)$)";
-        else if (unitLanguage == "C#")
-            pattern = R"(^(?:base|this|([^.->]*))(?:\.|->)([^.->\(\)]*)$)";
-    }
-
-    const std::regex regexPattern(pattern);
-    isMatched = std::regex_search(expr, match, regexPattern);
+    // If returnCheck is true, the match must reach the end of the expression. For example, return this.a; matches but return this.a.b; doesn't
+    std::string_view owner;
+    std::string_view member;
+    bool isMatched = matchAccessPath(expr, unitLanguage, returnCheck, owner, member);
     int count = isMatched ? 2 : 1;
     bool overShadow = true; // Needed in cases such as this.data = data where this.data is an attribute and data is a local or a parameter 
 
-    std::string possibleVar = expr; // For some reason, this fixes an issues dealing with invalid read memory caused by regex_search()
+    // 'variables' is the same map for all calls during an analysis (attributes for methods and parameters for free functions)
+    if (scope.getAttributeSource() != &variables)
+        scope.build(locals, parameters, variables, inheritedAttributes, variablesCreatedWithNew);
+
+    std::string_view possibleVarName = expr;
     for (int i = 0; i < count; i++) {
         if (isMatched && i == 0) {    
-            if (match[1] == "") {    
-                possibleVar = match[2]; // Case of base, super, and this 
+            if (owner.empty()) {    
+                possibleVarName = member; // Case of base, super, and this 
                 overShadow = false; 
             }   
             // 
             else if (!returnCheck)
-                possibleVar = match[1]; // Perhaps variable itself (e.g., a or a.foo())        
+                possibleVarName = owner; // Perhaps variable itself (e.g., a or a.foo())        
         } 
         // In C# or Java, a class name can be used to access static attributes only
         // In C++, a class name can be used to access static and non-static attributes
         // Parent class names can also be used to access attributes in the child class, but we will ignore this case for now
         // Checking with class name also avoids problems with other classes or properties having the same names as the attributes in the current class
-        else if (isMatched && match[1] != "") {// Case of class name itself
-            std::string possibleClassName = match[1];
-            std::size_t listOpen = possibleClassName.find("<");
-            if (listOpen != std::string::npos) 
-                possibleClassName = possibleClassName.substr(0, listOpen);
+        else if (isMatched && !owner.empty()) {// Case of class name itself
+            std::string_view possibleClassName = owner.substr(0, owner.find("<"));
             if (classNameParsed == possibleClassName)
-                possibleVar = match[2];
+                possibleVarName = member;
         }
 
+        // A name that was never interned can't be a variable
+        symbol possibleVar = 0;
+        if (!SYMBOLS.findLocal(possibleVarName, possibleVar)) continue;
+        const scopeEntry* entry = scope.find(possibleVar);
+        if (!entry) continue;
+
         if (overShadow) {
             // Checked first in case of overshadowing if variables = attributes
             // Case of variables = locals
-            if (locals.find(possibleVar) != locals.end()) {
-                if (localModifiedCheck && locals.at(possibleVar).getNonPrimitive()) 
+            if (entry->tags & SCOPE_LOCAL) {
+                if (localModifiedCheck && (entry->flags & SCOPE_LOCAL_NON_PRIMITIVE)) 
                     nonPrimitiveLocalOrParameterChanged = true;
                 if (returnCheck) { 
-                    if (variablesCreatedWithNew.find(possibleVar) != variablesCreatedWithNew.end())
+                    if (entry->flags & SCOPE_CREATED_WITH_NEW)
                         ++numOfVariablesReturnedCreatedWithNew;
                 }
                 if (isLocalCheck)
@@ -895,14 +913,14 @@ bool methodModel::isVariableUsed(std::unordered_map<std::string, variable>& vari
             }
 
             // Case of variables = parameters
-            else if (parameters.find(possibleVar) != parameters.end()) {
+            else if (entry->tags & SCOPE_PARAMETER) {
                 parameterUsed = true;
                 if (parameterModifiedCheck) {
-                    if (parameters.at(possibleVar).getNonPrimitive()) nonPrimitiveLocalOrParameterChanged = true;
+                    if (entry->flags & SCOPE_PARAMETER_NON_PRIMITIVE) nonPrimitiveLocalOrParameterChanged = true;
                     isParameterRefChanged(possibleVar, isMatched);
                 }
                 if (returnCheck) {        
-                    if (variablesCreatedWithNew.find(possibleVar) != variablesCreatedWithNew.end())
+                    if (entry->flags & SCOPE_CREATED_WITH_NEW)
                         ++numOfVariablesReturnedCreatedWithNew;
                 }
                 if (isParamaterCheck)
@@ -913,17 +931,17 @@ bool methodModel::isVariableUsed(std::unordered_map<std::string, variable>& vari
         }
 
         // Case of variables = attributes
-        if (variables.find(possibleVar) != variables.end()) {
+        if (entry->tags & (SCOPE_ATTRIBUTE | SCOPE_INHERITED_ATTRIBUTE | SCOPE_THIS)) {
             if (attributesModified)
                 if (attributesModified->find(possibleVar) == attributesModified->end())
                     attributesModified->insert(possibleVar);
             
             attributeUsed = true;
-            if (possibleVar != "this") { 
-                nonPrimitiveAttributeExternal = variables.at(possibleVar).getNonPrimitiveExternal(); 
+            if (!(entry->tags & SCOPE_THIS)) { 
+                nonPrimitiveAttributeExternal = entry->flags & SCOPE_ATTRIBUTE_NON_PRIMITIVE_EXTERNAL; 
                 if (returnCheck) {
                     attributeReturned = true; // Simple return     
-                    if (variablesCreatedWithNew.find(possibleVar) != variablesCreatedWithNew.end())
+                    if (entry->flags & SCOPE_CREATED_WITH_NEW)
                         ++numOfVariablesReturnedCreatedWithNew;
                 }
             }
@@ -937,18 +955,126 @@ bool methodModel::isVariableUsed(std::unordered_map<std::string, variable>& vari
     return false;  
 }
 
-void methodModel::setStereotype(const std::string& s) {
-    stereotype.push_back(s);
+// Writes all data of the method (used by checkpoints)
+//
+void methodModel::writeCheckpoint(std::ostream& out) const {
+    writeString(out, name);
+    writeString(out, getNameSignature());
+    writeString(out, returnType);
+    writeString(out, returnTypeParsed);
+    writeString(out, parametersList);
+    writeString(out, unitLanguage);
+    writeString(out, xpath);
+    writeString(out, srcML.getData());
+    writeInteger(out, srcML.getSize());
+    writeString(out, classNameParsed);
+    writeStereotypeSet(out, stereotype);
+
+    writeInteger(out, constMethod);
+    writeInteger(out, attributeReturned);
+    writeInteger(out, attributeNotReturned);
+    writeInteger(out, parameterNotReturned);
+    writeInteger(out, parameterRefChanged);
+    writeInteger(out, nonPrimitiveLocalOrParameterChanged);
+    writeInteger(out, globalOrStaticChanged);
+    writeInteger(out, parameterUsed);
+    writeInteger(out, attributeUsed);
+    writeInteger(out, empty);
+    writeInteger(out, strictFactory);
+    writeInteger(out, factory);
+    writeInteger(out, nonPrimitiveAttributeExternal);
+    writeInteger(out, nonPrimitiveReturnType);
+    writeInteger(out, nonPrimitiveReturnTypeExternal);
+    writeInteger(out, nonPrimitiveLocalExternal);
+    writeInteger(out, nonPrimitiveParamaterExternal);
+    writeInteger(out, newReturned);
+    writeInteger(out, constructorDestructorUsed);
+    writeInteger(out, destructor);
+    writeInteger(out, unitNumber);
+    writeInteger(out, numOfVariablesReturnedCreatedWithNew);
+    writeInteger(out, numOfAttributesModified);
+    writeInteger(out, numOfExternalFunctionCalls);
+    writeInteger(out, numOfExternalMethodCalls);
+    writeInteger(out, numOfFunctionCalls);
+    writeInteger(out, numOfMethodCalls);
+    writeInteger(out, numOfConstructorCalls);
 }
 
-std::string methodModel::getStereotype() const {
-    std::string result;
+// Approximate memory held by the method outside of its analysis (used by --max-memory)
+// The facts collected while the method is analyzed are not included, since they are released after
+//
+std::size_t methodModel::getMemorySize() const {
+    return sizeof(methodModel) + name.capacity() + returnType.capacity() + returnTypeParsed.capacity() +
+           parametersList.capacity() + unitLanguage.capacity() + xpath.capacity() + classNameParsed.capacity() +
+           srcML.getData().capacity();
+}
 
-    for (const std::string &value : stereotype)
-        result += value + " ";
+// Reads all data of the method written by writeCheckpoint()
+//
+void methodModel::readCheckpoint(std::istream& in) {
+    name = readString(in);
+    nameSignature = SYMBOLS.intern(readString(in));
+    returnType = readString(in);
+    returnTypeParsed = readString(in);
+    parametersList = readString(in);
+    unitLanguage = readString(in);
+    xpath = readString(in);
+    std::string compressedSrcML = readString(in);
+    srcML = compressedText(std::move(compressedSrcML), readInteger(in));
+    classNameParsed = readString(in);
+    stereotype = readStereotypeSet(in);
+
+    constMethod = readInteger(in) != 0;
+    attributeReturned = readInteger(in) != 0;
+    attributeNotReturned = readInteger(in) != 0;
+    parameterNotReturned = readInteger(in) != 0;
+    parameterRefChanged = readInteger(in) != 0;
+    nonPrimitiveLocalOrParameterChanged = readInteger(in) != 0;
+    globalOrStaticChanged = readInteger(in) != 0;
+    parameterUsed = readInteger(in) != 0;
+    attributeUsed = readInteger(in) != 0;
+    empty = readInteger(in) != 0;
+    strictFactory = readInteger(in) != 0;
+    factory = readInteger(in) != 0;
+    nonPrimitiveAttributeExternal = readInteger(in) != 0;
+    nonPrimitiveReturnType = readInteger(in) != 0;
+    nonPrimitiveReturnTypeExternal = readInteger(in) != 0;
+    nonPrimitiveLocalExternal = readInteger(in) != 0;
+    nonPrimitiveParamaterExternal = readInteger(in) != 0;
+    newReturned = readInteger(in) != 0;
+    constructorDestructorUsed = readInteger(in) != 0;
+    destructor = readInteger(in) != 0;
+    unitNumber = readInteger(in);
+    numOfVariablesReturnedCreatedWithNew = readInteger(in);
+    numOfAttributesModified = readInteger(in);
+    numOfExternalFunctionCalls = readInteger(in);
+    numOfExternalMethodCalls = readInteger(in);
+    numOfFunctionCalls = readInteger(in);
+    numOfMethodCalls = readInteger(in);
+    numOfConstructorCalls = readInteger(in);
+}
 
-    if (result != "") 
-        Rtrim(result);
+// Writes the methods from first on as one chunk at the end of the spill file
+// Returns the offset of the chunk
+//
+std::int64_t writeSpilledMethods(std::ostream& out, const std::vector<methodModel>& methods, std::size_t first) {
+    out.seekp(0, std::ios::end);
+    std::int64_t offset = out.tellp();
+    writeInteger(out, methods.size() - first);
+    for (std::size_t i = first; i < methods.size(); ++i)
+        methods[i].writeCheckpoint(out);
+    return offset;
+}
 
-    return result;
+// Appends the methods of the chunk at offset
+//
+void readSpilledMethods(std::istream& in, std::int64_t offset, std::vector<methodModel>& methods) {
+    in.clear();
+    in.seekg(offset);
+    std::int64_t count = readInteger(in);
+    for (std::int64_t i = 0; in && i < count; ++i) {
+        methods.emplace_back();
+        methods.back().readCheckpoint(in);
+    }
+    if (!in) std::cerr << "Error: Unable to read spilled methods" << '\n';
 }
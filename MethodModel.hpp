@@ -16,24 +16,29 @@
 #include "XPathBuilder.hpp"
 #include "IgnorableCalls.hpp"
 #include "calls.hpp"
+#include "Serialization.hpp"
+#include "ScopeTable.hpp"
+#include "Stereotype.hpp"
+#include "CompressedText.hpp"
 
 class methodModel {
 public:
+    methodModel() = default;
     methodModel(srcml_archive*, srcml_unit*, const std::string&, const std::string&, const std::string&, int);
+    methodModel(methodModel&&) = default;
+    methodModel& operator=(methodModel&&) = default;
+
+    // Methods are moved, not copied (each holds its srcML until it is analyzed). Copies are explicit
+    methodModel              clone                              () const                { return methodModel(*this);                        }
 
-    const std::vector<variable>&    getParametersOrdered                () const                { return parametersOrdered;     }
-    const std::vector<calls>&       getFunctionCalls                    () const                { return functionCalls;         }
-    const std::vector<calls>&       getMethodCalls                      () const                { return methodCalls;           }
-    const std::vector<calls>&       getConstructorCalls                 () const                { return constructorCalls;      }
-    
     const std::string&              getName                             () const                { return name;                                     }
-    const std::string&              getNameSignature                    () const                { return nameSignature;                            }
+    const std::string&              getNameSignature                    () const                { return SYMBOLS.getString(nameSignature);         }
+    symbol                          getNameSignatureSymbol              () const                { return nameSignature;                            }
     const std::string&              getParametersList                   () const                { return parametersList;                           }
-    const std::string&              getSrcML                            () const                { return srcML;                                    }
     const std::string&              getReturnType                       () const                { return returnType;                               }
     const std::string&              getReturnTypeParsed                 () const                { return returnTypeParsed;                         }
-    std::string                     getStereotype                       () const;
-    const std::vector<std::string>& getStereotypeList                   () const                { return stereotype;                               }
+    const std::string&              getStereotype                       () const                { return stereotype.getString();                   }
+    const stereotypeSet&            getStereotypeSet                    () const                { return stereotype;                               }
     const std::string&              getXpath                            () const                { return xpath;                                    } 
     const std::string&              getUnitLanguage                     () const                { return unitLanguage;                             } 
     
@@ -41,6 +46,9 @@ public:
     int                      getUnitNumber                      () const                { return unitNumber;                                }  
     int                      getNumOfExternalFunctionCalls      () const                { return numOfExternalFunctionCalls;                } 
     int                      getNumOfExternalMethodCalls        () const                { return numOfExternalMethodCalls;                  } 
+    int                      getNumOfFunctionCalls              () const                { return numOfFunctionCalls;                        }
+    int                      getNumOfMethodCalls                () const                { return numOfMethodCalls;                          }
+    int                      getNumOfConstructorCalls           () const                { return numOfConstructorCalls;                     }
     bool                     IsConstMethod                      () const                { return constMethod;                               }
     bool                     IsAttributeReturned                () const                { return attributeReturned;                         }
     bool                     IsAttributeNotReturned             () const                { return attributeNotReturned;                      }
@@ -57,16 +65,20 @@ public:
     bool                     IsNonPrimitiveLocalExternal        () const                { return nonPrimitiveLocalExternal;                 }  
     bool                     IsNonPrimitiveParamaterExternal    () const                { return nonPrimitiveParamaterExternal;             }  
     bool                     IsConstructorDestructorUsed        () const                { return constructorDestructorUsed;                 }  
+    bool                     IsDestructor                       () const                { return destructor;                                }  
     
     bool                     IsNonPrimitiveLocalOrParameterChanged () const             { return nonPrimitiveLocalOrParameterChanged;                 }  
-    void                     setStereotype                         (const std::string&);
+    void                     setStereotype                         (stereotypeSet s)    { stereotype = s;                                   }
+    void                     clearStereotype                       ()                   { stereotype.clear();                               }
 
-    void                     findMethodData                        (std::unordered_map<std::string, variable>&,
-                                                                   const std::unordered_set<std::string>&, 
-                                                                   const std::unordered_set<std::string>&, const std::string&);
+    void                     findMethodData                        (variableMap&, const std::vector<attributeLayer>&,
+                                                                   const symbolSet&, const std::string&,
+                                                                   std::pmr::memory_resource*);
 
     void                     findCommonData             ();
-    void                     findFreeFunctionData       ();
+    void                     useMemoryResource          (std::pmr::memory_resource*);
+    void                     releaseMethodData          ();
+    void                     findFreeFunctionData       (std::pmr::memory_resource*);
     void                     findMethodName             (srcml_archive*, srcml_unit*);
     void                     findMethodReturnType       (srcml_archive*, srcml_unit*);
     void                     findParameterList          (srcml_archive*, srcml_unit*);
@@ -80,39 +92,46 @@ public:
     void                     findNewAssign              (srcml_archive*, srcml_unit*);
     void                     isConst                    (srcml_archive*, srcml_unit*);
     void                     isConstructorDestructor    (srcml_archive*, srcml_unit*);
-    void                     isIgnorableCall            (std::vector<calls>&);
-    void                     isCallOnAttribute          (std::unordered_map<std::string, variable>&, 
-                                                         const std::unordered_set<std::string>&, const std::unordered_set<std::string>&);   
+    void                     isIgnorableCall            (std::pmr::vector<calls>&);
+    void                     isCallOnAttribute          (variableMap&, const symbolSet&);   
     void                     isCallOnParameter          ();
-    void                     isVariableReturned         (std::unordered_map<std::string, variable>&, bool);
-    void                     isVariableModified         (srcml_archive*, srcml_unit*, std::unordered_map<std::string, variable>&, bool);                             
-    void                     isVariableUsedInExpression (srcml_archive*, srcml_unit*, std::unordered_map<std::string, variable>&, bool);
-    void                     isParameterRefChanged      (std::string, bool);      
+    void                     isVariableReturned         (variableMap&, bool);
+    void                     isVariableModified         (srcml_archive*, srcml_unit*, variableMap&, bool);                             
+    void                     isVariableUsedInExpression (srcml_archive*, srcml_unit*, variableMap&, bool);
+    void                     isParameterRefChanged      (symbol, bool);      
+
+    std::size_t              getMemorySize              () const;
+    void                     writeCheckpoint            (std::ostream&) const;
+    void                     readCheckpoint             (std::istream&);
 
-    bool                     isVariableUsed             (std::unordered_map<std::string, variable>&, std::unordered_set<std::string>*, const std::string&, bool, bool, bool, bool, bool);
+    bool                     isVariableUsed             (variableMap&, symbolSet*, std::string_view, bool, bool, bool, bool, bool);
     void                     isEmpty                    (srcml_archive*, srcml_unit*);
     void                     isFactory                  ();
                                              
 private:
+    methodModel(const methodModel&) = default;
+
     std::string                                       name;                                       // Name without namespaces
-    std::string                                       nameSignature;                              // Name without namespaces + parameters list (commas only). For example, foo(,,)
+    symbol                                            nameSignature{0};                           // Name without namespaces + parameters list (commas only). For example, foo(,,)
     std::string                                       returnType;                                 // Return type without whitespaces
     std::string                                       returnTypeParsed;                           // Return type without specifiers, containers, and whitespaces
     std::string                                       parametersList;                             // Parameters list
     std::string                                       unitLanguage;                               // Unit language
     std::string                                       xpath;                                      // Unique xpath
-    std::string                                       srcML;                                      // Method srcML
-    std::vector<variable>                             parametersOrdered;                          // List of all parameters (Needed in order to build the parameters map)
-    std::vector<variable>                             localsOrdered;                              // List of all local (Needed in order to build the locals map)     
-    std::unordered_map<std::string, variable>         parameters;                                 // Map of all parameters. Key is parameter name
-    std::unordered_map<std::string, variable>         locals;                                     // Map of all locals. Key is local name         
+    compressedText                                    srcML;                                      // Method srcML (compressed). Released once the method is analyzed
+    std::pmr::vector<variable>                        parametersOrdered;                          // List of all parameters (Needed in order to build the parameters map)
+    std::pmr::vector<variable>                        localsOrdered;                              // List of all local (Needed in order to build the locals map)     
+    variableMap                                       parameters;                                 // Map of all parameters. Key is parameter name
+    variableMap                                       locals;                                     // Map of all locals. Key is local name         
     std::string                                       classNameParsed;                            // Class name without whitespaces, namespaces, and generic types <>
-    std::unordered_set<std::string>                   variablesCreatedWithNew;                    // List of variables that are declared/initialized with the "new" operator
-    std::vector<std::string>                          stereotype;                                 // Method stereotype
-    std::vector<calls>                                functionCalls;                              // List of function calls (e.g., foo()) to methods in class. Constructor calls to class are not considered
-    std::vector<calls>                                methodCalls;                                // List of method calls (e.g., a.foo()) where 'a' is an attribute
-    std::vector<calls>                                constructorCalls;                           // List of constructor calls
-    std::vector<std::string>                          returnExpressions;                          // List of all return expressions in a method
+    symbolSet                                         variablesCreatedWithNew;                    // List of variables that are declared/initialized with the "new" operator
+    scopeTable                                        scope;                                      // Locals, parameters, and attributes used to resolve names (built on first use)
+    const std::vector<attributeLayer>*                inheritedAttributes{nullptr};               // Attributes inherited by the class of the method (only set during analysis)
+    stereotypeSet                                     stereotype;                                 // Method stereotype (or free function stereotype)
+    std::pmr::vector<calls>                           functionCalls;                              // List of function calls (e.g., foo()) to methods in class. Constructor calls to class are not considered
+    std::pmr::vector<calls>                           methodCalls;                                // List of method calls (e.g., a.foo()) where 'a' is an attribute
+    std::pmr::vector<calls>                           constructorCalls;                           // List of constructor calls
+    std::pmr::vector<std::pmr::string>                returnExpressions;                          // List of all return expressions in a method
     bool                                              constMethod{false};                         // Is it a const method? C++ only
     bool                                              attributeReturned{false};                   // Does it contains at least 1 simple return that returns an attribute? (e.g., return a; where 'a' is an attribute)
     bool                                              attributeNotReturned{false};                // Does it contains at least 1 return that is not a simple return?
@@ -132,12 +151,20 @@ private:
     bool                                              nonPrimitiveParamaterExternal{false};       // True if method uses at least 1 a non-primitive parameter that is not of the same type as class                                                
     bool                                              newReturned{false};                         // There is at least one return that a return a "new" call
     bool                                              constructorDestructorUsed{false};           // Method is a constructor or a destructor
+    bool                                              destructor{false};                          // Method is a destructor
     int                                               unitNumber{-1};                             // Unit number
     int                                               numOfVariablesReturnedCreatedWithNew{0};    // Number of return expressions that return a local, parameter, or an attribute created with the "new" operator
     int                                               numOfAttributesModified{0};                 // Number of modified attributes
     int                                               numOfExternalFunctionCalls{0};              // Number of function calls that are filtered (removed)
     int                                               numOfExternalMethodCalls{0};                // Number of method calls that are filtered (removed)
+    int                                               numOfFunctionCalls{0};                      // Number of function calls to methods in class (kept after the calls are released)
+    int                                               numOfMethodCalls{0};                        // Number of method calls on attributes (kept after the calls are released)
+    int                                               numOfConstructorCalls{0};                   // Number of constructor calls (kept after the calls are released)
 
 };
 
+// Spill file of the methods (--max-memory). Methods are written in chunks with the checkpoint format
+std::int64_t                writeSpilledMethods         (std::ostream&, const std::vector<methodModel>&, std::size_t);
+void                        readSpilledMethods          (std::istream&, std::int64_t, std::vector<methodModel>&);
+
 #endif
@@ -11,12 +11,105 @@
 
 extern std::vector<std::string> LANGUAGE;
 
+// Built-in primitives per language
+// Generic types (e.g., T), auto (C++), and var (C# and Java) 
+//  are considered as non-primitive unless added by user
+//
+constexpr perfectHashSet CPP_PRIMITIVES = {
+    "short",
+    "shortint",
+    "int",
+    "int8_t",
+    "int16_t",
+    "int32_t",
+    "int64_t",
+    "uint8_t",
+    "uint16_t",
+    "uint32_t",
+    "uint64_t",
+    "long",
+    "longint",
+    "longlong",
+    "longlongint",
+    "float",
+    "double",
+    "longdouble",
+    "char",
+    "byte",
+    "string",
+    "size_type",
+    "size_t",
+    "wchar_t",
+    "char16_t",
+    "char32_t",
+    "bool",
+    "ptrdiff_t",
+    "void"
+};
+
+constexpr perfectHashSet CSHARP_PRIMITIVES = {
+    "bool",
+    "byte",
+    "sbyte",
+    "char",
+    "double",
+    "float",
+    "int",
+    "uint",
+    "long",
+    "ulong",
+    "short",
+    "ushort",
+    "decimal",
+    "string",
+    "void",
+    "Boolean",
+    "Byte",
+    "SByte",
+    "Char",
+    "Double",
+    "Single",
+    "Int32",
+    "UInt32",
+    "Int64",
+    "UInt64",
+    "Int16",
+    "IntPtr",
+    "UIntPtr",
+    "UInt16",
+    "Decimal",
+    "String",
+    "Void"
+};
+
+constexpr perfectHashSet JAVA_PRIMITIVES = {
+    "boolean",
+    "byte",
+    "char",
+    "short",
+    "int",
+    "long",
+    "float",
+    "double",
+    "void",
+    "Byte",
+    "Character",
+    "Short",
+    "Integer",
+    "Long",
+    "Float",
+    "Double",
+    "String",
+    "Void"
+};
+
 // Checks if 'type' is a primitive
 // User-defined primitives are checked for all languages
 //
-bool primitiveTypes::isPrimitive(const std::string& type, const std::string& unitLanguage) {
-    return (ptypes.at(unitLanguage).find(type) != ptypes.at(unitLanguage).end() || 
-           userTypes.find(type) != userTypes.end());
+bool primitiveTypes::isPrimitive(std::string_view type, std::string_view unitLanguage) const {
+    for (const auto& pair : ptypes)
+        if (pair.first == unitLanguage && pair.second->contains(type)) return true;
+    return userTypes.contains(type);
 }
 
 // Reads a set of user-defined primitive types
@@ -36,13 +129,54 @@ std::istream& operator>>(std::istream& in, primitiveTypes& primitives) {
 //
 void primitiveTypes::addPrimitive(const std::string& userType) {
     userTypes.insert(userType);
+    ++version;
+}
+
+// Adds 'value' if not already present
+//
+void openAddressingSet::insert(const std::string& value) {
+    if (contains(value)) return;
+
+    // Keeps the load factor at or below 1/2
+    if ((values.size() + 1) * 2 > slots.size())
+        rehash(slots.empty() ? 16 : slots.size() * 2);
+
+    values.push_back(value);
+    std::size_t mask = slots.size() - 1;
+    std::size_t index = std::hash<std::string_view>{}(value) & mask;
+    while (slots[index] != 0) index = (index + 1) & mask;
+    slots[index] = static_cast<std::uint32_t>(values.size());
+}
+
+bool openAddressingSet::contains(std::string_view value) const {
+    if (slots.empty()) return false;
+
+    std::size_t mask = slots.size() - 1;
+    std::size_t index = std::hash<std::string_view>{}(value) & mask;
+    while (slots[index] != 0) {
+        if (values[slots[index] - 1] == value) return true;
+        index = (index + 1) & mask;
+    }
+    return false;
+}
+
+// Rebuilds the slots with 'size' slots (power of 2)
+//
+void openAddressingSet::rehash(std::size_t size) {
+    slots.assign(size, 0);
+    std::size_t mask = size - 1;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::size_t index = std::hash<std::string_view>{}(values[i]) & mask;
+        while (slots[index] != 0) index = (index + 1) & mask;
+        slots[index] = static_cast<std::uint32_t>(i + 1);
+    }
 }
 
 void primitiveTypes::outputPrimitives() {
     std::cerr<<"---Primitives---";
     for (const auto& pair : ptypes) {
         std::cerr<<"\n[" << pair.first << "]:" ;
-        for (const std::string& primit : pair.second) 
+        for (std::string_view primit : *pair.second) 
             std::cerr << ' ' << primit;
     }
 
@@ -55,101 +189,19 @@ void primitiveTypes::outputPrimitives() {
 }
 
 // Specific primitives are used based on the language of the unit (i.e., source file)
-// Generic types (e.g., T), auto (C++), and var (C# and Java) 
-//  are considered as non-primitive unless added by user
 //
 void primitiveTypes::createPrimitiveList() {
+    ++version;
+    ptypes.clear();
     for (const auto& l : LANGUAGE) {
         if (l == "C++") {
-            ptypes.insert({l, {
-                "short",
-                "shortint",
-                "int",
-                "int8_t",
-                "int16_t",
-                "int32_t",
-                "int64_t",
-                "uint8_t",
-                "uint16_t",
-                "uint32_t",
-                "uint64_t",
-                "long",
-                "longint",
-                "longlong",
-                "longlongint",
-                "float",
-                "double",
-                "longdouble",
-                "char",
-                "byte",
-                "string",
-                "size_type",
-                "size_t",
-                "wchar_t",
-                "char16_t",
-                "char32_t",
-                "bool",
-                "ptrdiff_t",
-                "void"
-            }});
+            ptypes.push_back({l, &CPP_PRIMITIVES});
         }
         else if (l == "C#") {  
-            ptypes.insert({l, {
-                "bool",
-                "byte",
-                "sbyte",
-                "char",
-                "double",
-                "float",
-                "int",
-                "uint",
-                "long",
-                "ulong",
-                "short",
-                "ushort",
-                "decimal",
-                "string",
-                "void",
-                "Boolean",
-                "Byte",
-                "SByte",
-                "Char",
-                "Double",
-                "Single",
-                "Int32",
-                "UInt32",
-                "Int64",
-                "UInt64",
-                "Int16",
-                "IntPtr",
-                "UIntPtr",
-                "UInt16",
-                "Decimal",
-                "String",
-                "Void"
-            }});
+            ptypes.push_back({l, &CSHARP_PRIMITIVES});
         }
         else if (l == "Java") {
-            ptypes.insert({l, {
-                "boolean",
-                "byte",
-                "char",
-                "short",
-                "int",
-                "long",
-                "float",
-                "double",
-                "void",
-                "Byte",
-                "Character",
-                "Short",
-                "Integer",
-                "Long",
-                "Float",
-                "Double",
-                "String",
-                "Void"
-            }});
+            ptypes.push_back({l, &JAVA_PRIMITIVES});
         }
     }
 }
@@ -12,23 +12,96 @@
 
 #include <string>
 #include <fstream>
-#include <unordered_set>
-#include <unordered_map>
+#include <string_view>
+#include <array>
 #include <vector>
+#include <initializer_list>
+#include <functional>
 #include <iostream>
+#include <cstdint>
+
+// Set of strings with a perfect hash, built at compile time
+// A seed is searched so that every key hashes to a different slot, so a lookup
+//  is one hash and at most one string comparison
+//
+class perfectHashSet {
+public:
+    static constexpr std::size_t MAX_KEYS = 64;
+    static constexpr std::size_t SIZE     = 256;  // Number of slots (power of 2, keeps the seed search short)
+
+    constexpr perfectHashSet(std::initializer_list<std::string_view> list) {
+        for (std::string_view key : list) keys[count++] = key;
+        while (!tryBuild(seed)) ++seed;
+    }
+
+    constexpr bool contains(std::string_view key) const {
+        std::uint8_t slot = slots[hash(key, seed) & (SIZE - 1)];
+        return slot != 0 && keys[slot - 1] == key;
+    }
+
+    const std::string_view* begin() const { return keys.data(); }
+    const std::string_view* end() const { return keys.data() + count; }
+
+private:
+    // FNV-1a mixed with the seed
+    static constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed) {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    constexpr bool tryBuild(std::uint32_t s) {
+        for (std::size_t i = 0; i < SIZE; ++i) slots[i] = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t index = hash(keys[i], s) & (SIZE - 1);
+            if (slots[index] != 0) return false;
+            slots[index] = static_cast<std::uint8_t>(i + 1);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, MAX_KEYS>  keys{};
+    std::array<std::uint8_t, SIZE>          slots{};   // Index + 1 of the key in each slot, 0 is empty
+    std::size_t                             count{0};
+    std::uint32_t                           seed{1};
+};
+
+// Set of strings with open addressing (linear probing)
+// Lookups take a string_view, so no string is created to check a type
+//
+class openAddressingSet {
+public:
+    void                 insert                  (const std::string&);
+    bool                 contains                (std::string_view) const;
+    std::size_t          size                    () const      { return values.size(); }
+    
+    std::vector<std::string>::const_iterator begin() const     { return values.begin(); }
+    std::vector<std::string>::const_iterator end() const       { return values.end(); }
+
+private:
+    void                 rehash                  (std::size_t);
+
+    std::vector<std::string>                     values;         // In insertion order
+    std::vector<std::uint32_t>                   slots;          // Index + 1 of the value in each slot, 0 is empty
+};
 
 class primitiveTypes {
 public:
-    bool                 isPrimitive             (const std::string&, const std::string&);
+    bool                 isPrimitive             (std::string_view, std::string_view) const;
 
     void                 addPrimitive            (const std::string&);
     void                 createPrimitiveList     ();
     void                 outputPrimitives        ();
+    std::uint64_t        getVersion              () const      { return version; }
 
     friend std::istream& operator>>              (std::istream&, primitiveTypes&);
 private:
-    std::unordered_map<std::string, std::unordered_set<std::string>>     ptypes;         // List of primitives
-    std::unordered_set<std::string>                                      userTypes;      // List of user-defined primitives
+    std::vector<std::pair<std::string, const perfectHashSet*>>           ptypes;         // List of primitives per language
+    openAddressingSet                                                    userTypes;      // List of user-defined primitives
+    std::uint64_t                                                        version{0};     // Incremented when the primitives change
 };
 
 #endif
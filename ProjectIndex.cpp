@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file ProjectIndex.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "ProjectIndex.hpp"
+
+// Finds an indexed class given the name of a parent class
+// Same matching as findInheritedAttributes() in classModelCollection
+//
+const classModel* projectIndex::findClass(const std::string& className, const std::string& unitLanguage) const {
+    auto result = indexedClasses.find(className);
+    if (result != indexedClasses.end()) return &result->second;
+
+    if (unitLanguage == "C++") {
+        result = indexedClasses.find(className.substr(0, className.find("<")));
+        if (result != indexedClasses.end()) return &result->second;
+    }
+    else {
+        std::string genericName = className;
+        removeBetweenComma(genericName, true);
+        auto resultG = indexedGenerics.find(genericName);
+        if (resultG != indexedGenerics.end()) {
+            result = indexedClasses.find(resultG->second);
+            if (result != indexedClasses.end()) return &result->second;
+        }
+    }
+    return nullptr;
+}
+
+// Finds an indexed class given its name without whitespaces
+// Classes from module summaries are not returned since they can't have parts in the input archive
+//
+const classModel* projectIndex::findIndexedClass(const std::string& className) const {
+    auto result = indexedClasses.find(className);
+    if (result != indexedClasses.end() && !isSummaryClass(className)) return &result->second;
+    return nullptr;
+}
+
+// Reads a project index or a module summary written by classModelCollection::outputIndex()
+// Sets the failbit of the stream if the file is not a project index or if it is from a different version
+//
+std::istream& operator>>(std::istream& in, projectIndex& index) {
+    std::string magic(PROJECT_INDEX_MAGIC.size(), '\0');
+    in.read(&magic[0], magic.size());
+    if (!in || magic != PROJECT_INDEX_MAGIC || readInteger(in) != PROJECT_INDEX_VERSION) {
+        in.setstate(std::ios::failbit);
+        return in;
+    }
+    std::int64_t kind = readInteger(in);
+
+    std::int64_t count = readInteger(in);
+    for (std::int64_t i = 0; in && i < count; ++i) {
+        classModel c;
+        c.readIndex(in);
+        if (!in) break;
+
+        index.addClass(std::move(c), kind == MODULE_SUMMARY_KIND);
+    }
+    return in;
+}
+
+// Adds a class to the index unless a class with the same name is already indexed
+//
+void projectIndex::addClass(classModel&& c, bool summary) {
+    if (indexedClasses.find(c.getName()[1]) != indexedClasses.end()) return;
+    if (summary) summaryClasses.insert(c.getName()[1]);
+
+    if (c.getUnitLanguage() != "C++") indexedGenerics.insert({c.getName()[2], c.getName()[1]});
+    std::string className = c.getName()[1];
+    indexedClasses.emplace(className, std::move(c));
+}
+
+// Finds a class of an external framework given the name of a parent class
+// Only classes of the same language are matched
+//
+const classModel* summaryPacks::findClass(const std::string& className, const std::string& unitLanguage) const {
+    auto result = packs.find(unitLanguage);
+    if (result == packs.end()) return nullptr;
+    return result->second.findClass(className, unitLanguage);
+}
+
+// Loads all summary packs (files with the .summary extension) in a directory
+// Files are loaded in name order
+// Returns the name of the first file that can't be loaded, or an empty string on success
+//
+std::string summaryPacks::loadDirectory(const std::string& directory) {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        if (entry.is_regular_file(error) && entry.path().extension() == ".summary")
+            files.push_back(entry.path().string());
+    std::sort(files.begin(), files.end());
+
+    for (const std::string& file : files) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in.is_open() || !(in >> *this)) return file;
+    }
+    return "";
+}
+
+// Reads a summary pack (a module summary written by classModelCollection::outputIndex())
+// Classes are grouped by language since frameworks of different languages can use the same class names
+//
+std::istream& operator>>(std::istream& in, summaryPacks& packs) {
+    projectIndex pack;
+    if (!(in >> pack)) return in;
+
+    for (const auto& pair : pack.getIndexedClasses())
+        packs.packs[pair.second.getUnitLanguage()].addClass(pair.second.clone(), true);
+    return in;
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file ProjectIndex.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef PROJECTINDEX_HPP
+#define PROJECTINDEX_HPP
+
+#include <filesystem>
+#include "ClassModel.hpp"
+
+// Project index
+// Classes of a whole project after inheritance (names, parents, attributes, method signatures, and method stereotypes)
+// Used to stereotype a subset of the project (e.g., a single file) with the same results as a full run
+// Module summaries (classes of other srcML archives) can also be loaded. Their classes are only used as parent classes
+// If a class is loaded more than once, the first one is kept
+//
+class projectIndex {
+public:
+    const classModel*    findClass               (const std::string&, const std::string&) const;
+    const classModel*    findIndexedClass        (const std::string&) const;
+    void                 addClass                (classModel&&, bool);
+    bool                 empty                   () const                                           { return indexedClasses.empty(); }
+    bool                 isSummaryClass          (const std::string& className) const               { return summaryClasses.find(className) != summaryClasses.end(); }
+
+    const std::unordered_map<std::string, classModel>& getIndexedClasses () const                  { return indexedClasses; }
+
+    friend std::istream& operator>>              (std::istream&, projectIndex&);
+private:
+    std::unordered_map<std::string, classModel>     indexedClasses;     // List of class names and their models
+    std::unordered_map<std::string, std::string>    indexedGenerics;    // List of generic class names with and without <> for inheritance matching
+    std::unordered_set<std::string>                 summaryClasses;     // Classes loaded from module summaries
+};
+
+// Summary packs
+// Module summaries of external frameworks (e.g., JDK, .NET BCL, or Qt) whose sources are not analyzed
+// Only used as parent classes when a parent is not in the input archive, the project index, or the module summaries
+//
+class summaryPacks {
+public:
+    const classModel*    findClass               (const std::string&, const std::string&) const;
+    std::string          loadDirectory           (const std::string&);
+
+    friend std::istream& operator>>              (std::istream&, summaryPacks&);
+private:
+    std::unordered_map<std::string, projectIndex>   packs;              // Key is language and value is the classes of all packs of that language
+};
+
+const std::string        PROJECT_INDEX_MAGIC     = "STEREOCODE-INDEX";
+const std::int64_t       PROJECT_INDEX_VERSION   = 3;
+const std::int64_t       PROJECT_INDEX_KIND      = 0;   // Project index (--save-index)
+const std::int64_t       MODULE_SUMMARY_KIND     = 1;   // Module summary (--export-summary)
+
+#endif
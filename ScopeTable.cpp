@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file ScopeTable.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "ScopeTable.hpp"
+
+// Builds the table from the locals, parameters, and attributes of a method
+// For free functions, the parameters are also passed as the attributes and there are no inherited attributes
+//
+void scopeTable::build(const variableMap& locals, const variableMap& parameters, const variableMap& attributes, 
+                       const std::vector<attributeLayer>* inheritedAttributes, const symbolSet& createdWithNew) {
+    std::size_t count = locals.size() + parameters.size() + attributes.size() + createdWithNew.size();
+    if (inheritedAttributes)
+        for (const auto& layer : *inheritedAttributes) count += layer->size();
+
+    // Load factor is kept at or below 1/2
+    std::size_t size = 16;
+    while (size < 2 * count) size *= 2;
+    entries.assign(size, {EMPTY, 0, 0});
+    attributeSource = &attributes;
+
+    for (const auto& pair : locals) {
+        scopeEntry& entry = insert(pair.first);
+        entry.tags |= SCOPE_LOCAL;
+        if (pair.second.getNonPrimitive()) entry.flags |= SCOPE_LOCAL_NON_PRIMITIVE;
+    }
+    for (const auto& pair : parameters) {
+        scopeEntry& entry = insert(pair.first);
+        entry.tags |= SCOPE_PARAMETER;
+        if (pair.second.getNonPrimitive()) entry.flags |= SCOPE_PARAMETER_NON_PRIMITIVE;
+    }
+    for (const auto& pair : attributes) {
+        scopeEntry& entry = insert(pair.first);
+        if (SYMBOLS.getString(pair.first) == "this") entry.tags |= SCOPE_THIS;
+        else if (pair.second.getInherited()) entry.tags |= SCOPE_INHERITED_ATTRIBUTE;
+        else entry.tags |= SCOPE_ATTRIBUTE;
+        if (pair.second.getNonPrimitiveExternal()) entry.flags |= SCOPE_ATTRIBUTE_NON_PRIMITIVE_EXTERNAL;
+    }
+    // An attribute of the class hides inherited attributes with the same name, and
+    //  a layer hides the layers after it (layers are in the order the parents were inherited)
+    if (inheritedAttributes) {
+        for (const auto& layer : *inheritedAttributes) {
+            for (const auto& pair : *layer) {
+                scopeEntry& entry = insert(pair.first);
+                if (entry.tags & (SCOPE_ATTRIBUTE | SCOPE_INHERITED_ATTRIBUTE | SCOPE_THIS)) continue;
+                if (SYMBOLS.getString(pair.first) == "this") entry.tags |= SCOPE_THIS;
+                else entry.tags |= SCOPE_INHERITED_ATTRIBUTE;
+                if (pair.second.getNonPrimitiveExternal()) entry.flags |= SCOPE_ATTRIBUTE_NON_PRIMITIVE_EXTERNAL;
+            }
+        }
+    }
+    // Names created with new that are not variables of the method get an entry without tags
+    for (symbol name : createdWithNew)
+        insert(name).flags |= SCOPE_CREATED_WITH_NEW;
+}
+
+void scopeTable::clear() {
+    entries.clear();
+    attributeSource = nullptr;
+}
+
+// Returns the entry of 'name' or nullptr if it is not in the table
+//
+const scopeEntry* scopeTable::find(symbol name) const {
+    if (entries.empty()) return nullptr;
+
+    std::size_t mask = entries.size() - 1;
+    for (std::size_t index = slot(name); entries[index].name != EMPTY; index = (index + 1) & mask)
+        if (entries[index].name == name) return &entries[index];
+    return nullptr;
+}
+
+scopeEntry& scopeTable::insert(symbol name) {
+    std::size_t mask = entries.size() - 1;
+    std::size_t index = slot(name);
+    while (entries[index].name != EMPTY && entries[index].name != name) index = (index + 1) & mask;
+    entries[index].name = name;
+    return entries[index];
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file ScopeTable.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef SCOPETABLE_HPP
+#define SCOPETABLE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include "utils.hpp"
+
+// Tags of a name in the scope of a method
+// A name can have more than one tag. For example, a local that shadows an attribute
+//
+const std::uint8_t       SCOPE_LOCAL                        = 1;
+const std::uint8_t       SCOPE_PARAMETER                    = 2;
+const std::uint8_t       SCOPE_ATTRIBUTE                    = 4;
+const std::uint8_t       SCOPE_INHERITED_ATTRIBUTE          = 8;
+const std::uint8_t       SCOPE_THIS                         = 16;
+
+// Flags of a name precomputed from its variables
+//
+const std::uint8_t       SCOPE_LOCAL_NON_PRIMITIVE          = 1;
+const std::uint8_t       SCOPE_PARAMETER_NON_PRIMITIVE      = 2;
+const std::uint8_t       SCOPE_ATTRIBUTE_NON_PRIMITIVE_EXTERNAL = 4;
+const std::uint8_t       SCOPE_CREATED_WITH_NEW             = 8;
+
+struct scopeEntry {
+    symbol               name;
+    std::uint8_t         tags;
+    std::uint8_t         flags;
+};
+
+// All names a method can use (locals, parameters, and attributes) in one flat table
+// Inherited attributes are looked up in the layers of the parent classes once, when the table is built
+// Keyed by symbol with open addressing (linear probing), so a name is resolved with a single probe
+//
+class scopeTable {
+public:
+    void                 build                    (const variableMap&, const variableMap&, const variableMap&, 
+                                                   const std::vector<attributeLayer>*, const symbolSet&);
+    void                 clear                    ();
+    const scopeEntry*    find                     (symbol) const;
+
+    // Map of attributes the table was built with (nullptr if not built)
+    const void*          getAttributeSource       () const      { return attributeSource; }
+
+private:
+    scopeEntry&          insert                   (symbol);
+    std::size_t          slot                     (symbol id) const { return (id * 2654435769u) & (entries.size() - 1); }
+
+    static const symbol                 EMPTY = 0xFFFFFFFF;         // Name of an empty slot (never a valid symbol)
+
+    std::vector<scopeEntry>             entries;
+    const void*                         attributeSource{nullptr};
+};
+
+#endif
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file Serialization.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "Serialization.hpp"
+
+void writeInteger(std::ostream& out, std::int64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i)
+        bytes[i] = static_cast<char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xFF);
+    out.write(bytes, 8);
+}
+
+void writeString(std::ostream& out, const std::string& s) {
+    writeInteger(out, s.size());
+    out.write(s.data(), s.size());
+}
+
+void writeStringList(std::ostream& out, const std::vector<std::string>& list) {
+    writeInteger(out, list.size());
+    for (const auto& s : list) writeString(out, s);
+}
+
+void writeStringSet(std::ostream& out, const std::unordered_set<std::string>& set) {
+    writeInteger(out, set.size());
+    for (const auto& s : set) writeString(out, s);
+}
+
+void writeStringMap(std::ostream& out, const flatStringMap<std::string>& map) {
+    writeInteger(out, map.size());
+    for (const auto& pair : map) {
+        writeString(out, pair.first);
+        writeString(out, pair.second);
+    }
+}
+
+void writeVariable(std::ostream& out, const variable& v) {
+    writeString(out, v.getName());
+    writeString(out, v.getType());
+    writeInteger(out, v.getNonPrimitive());
+    writeInteger(out, v.getNonPrimitiveExternal());
+    writeInteger(out, v.getPos());
+    writeInteger(out, v.getInherited());
+}
+
+void writeSymbolSet(std::ostream& out, const symbolSet& set) {
+    writeInteger(out, set.size());
+    for (symbol s : set) writeString(out, SYMBOLS.getString(s));
+}
+
+void writeVariableMap(std::ostream& out, const variableMap& map) {
+    writeInteger(out, map.size());
+    for (const auto& pair : map) {
+        writeString(out, SYMBOLS.getString(pair.first));
+        writeVariable(out, pair.second);
+    }
+}
+
+void writeXpathMap(std::ostream& out, const std::unordered_map<int, std::vector<std::string>>& map) {
+    writeInteger(out, map.size());
+    for (const auto& pair : map) {
+        writeInteger(out, pair.first);
+        writeStringList(out, pair.second);
+    }
+}
+
+// Stereotypes are stored as their kind and bitmask (bits are fixed by the version of the format)
+//
+void writeStereotypeSet(std::ostream& out, const stereotypeSet& set) {
+    writeInteger(out, set.getKind());
+    writeInteger(out, set.getMask());
+}
+
+// Returns 0 and sets the failbit of the stream if the input is truncated
+//
+std::int64_t readInteger(std::istream& in) {
+    char bytes[8];
+    if (!in.read(bytes, 8)) return 0;
+
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    return static_cast<std::int64_t>(value);
+}
+
+std::string readString(std::istream& in) {
+    std::int64_t size = readInteger(in);
+    if (!in || size < 0) {
+        in.setstate(std::ios::failbit);
+        return "";
+    }
+
+    std::string s;
+    // Read in chunks so a corrupted size can't allocate a huge string up front
+    const std::int64_t chunk = 1 << 16;
+    while (in && size > 0) {
+        std::size_t n = static_cast<std::size_t>(std::min(size, chunk));
+        std::size_t offset = s.size();
+        s.resize(offset + n);
+        in.read(&s[offset], n);
+        size -= n;
+    }
+    return s;
+}
+
+std::vector<std::string> readStringList(std::istream& in) {
+    std::vector<std::string> list;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) list.push_back(readString(in));
+    return list;
+}
+
+std::unordered_set<std::string> readStringSet(std::istream& in) {
+    std::unordered_set<std::string> set;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) set.insert(readString(in));
+    return set;
+}
+
+flatStringMap<std::string> readStringMap(std::istream& in) {
+    flatStringMap<std::string> map;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) {
+        std::string key = readString(in);
+        map.insert({key, readString(in)});
+    }
+    return map;
+}
+
+variable readVariable(std::istream& in) {
+    variable v;
+    v.setName(SYMBOLS.intern(readString(in)));
+    v.setType(SYMBOLS.intern(readString(in)));
+    v.setNonPrimitive(readInteger(in));
+    v.setNonPrimitiveExternal(readInteger(in));
+    v.setPos(readInteger(in));
+    v.setInherited(readInteger(in));
+    return v;
+}
+
+symbolSet readSymbolSet(std::istream& in) {
+    symbolSet set;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) set.insert(SYMBOLS.intern(readString(in)));
+    return set;
+}
+
+variableMap readVariableMap(std::istream& in) {
+    variableMap map;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) {
+        symbol key = SYMBOLS.intern(readString(in));
+        map.insert({key, readVariable(in)});
+    }
+    return map;
+}
+
+std::unordered_map<int, std::vector<std::string>> readXpathMap(std::istream& in) {
+    std::unordered_map<int, std::vector<std::string>> map;
+    std::int64_t size = readInteger(in);
+    for (std::int64_t i = 0; in && i < size; ++i) {
+        int key = readInteger(in);
+        map.insert({key, readStringList(in)});
+    }
+    return map;
+}
+
+stereotypeSet readStereotypeSet(std::istream& in) {
+    int kind = readInteger(in);
+    std::uint32_t mask = readInteger(in);
+    if (kind < 0 || kind >= NUM_STEREOTYPE_KINDS) {
+        in.setstate(std::ios::failbit);
+        return stereotypeSet();
+    }
+    return stereotypeSet(kind, mask);
+}
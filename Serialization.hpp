@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file Serialization.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include "utils.hpp"
+#include "Stereotype.hpp"
+
+// Binary format used by the project index and checkpoints
+// Integers are stored in little-endian order and strings are prefixed by their size
+// Symbols are stored as their strings since symbol ids are only valid in one run
+//
+void                            writeInteger                  (std::ostream&, std::int64_t);
+void                            writeString                   (std::ostream&, const std::string&);
+void                            writeStringList               (std::ostream&, const std::vector<std::string>&);
+void                            writeStringSet                (std::ostream&, const std::unordered_set<std::string>&);
+void                            writeStringMap                (std::ostream&, const flatStringMap<std::string>&);
+void                            writeVariable                 (std::ostream&, const variable&);
+void                            writeSymbolSet                (std::ostream&, const symbolSet&);
+void                            writeVariableMap              (std::ostream&, const variableMap&);
+void                            writeXpathMap                 (std::ostream&, const std::unordered_map<int, std::vector<std::string>>&);
+void                            writeStereotypeSet            (std::ostream&, const stereotypeSet&);
+
+std::int64_t                    readInteger                   (std::istream&);
+std::string                     readString                    (std::istream&);
+std::vector<std::string>        readStringList                (std::istream&);
+std::unordered_set<std::string> readStringSet                 (std::istream&);
+flatStringMap<std::string>      readStringMap                 (std::istream&);
+variable                        readVariable                  (std::istream&);
+symbolSet                       readSymbolSet                 (std::istream&);
+variableMap                     readVariableMap               (std::istream&);
+std::unordered_map
+<int, std::vector<std::string>> readXpathMap                  (std::istream&);
+stereotypeSet                   readStereotypeSet             (std::istream&);
+#endif
@@ -0,0 +1,350 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file SourceWatcher.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "SourceWatcher.hpp"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+extern std::unordered_map
+       <int, std::unordered_map
+       <std::string, std::string>>   XPATH_LIST;
+
+#ifdef __linux__
+// Set by SIGINT or SIGTERM to end the watch loop
+static volatile sig_atomic_t STOP_WATCHING = 0;
+
+static void stopWatching(int) {
+    STOP_WATCHING = 1;
+}
+#endif
+
+sourceWatcher::sourceWatcher(const std::string& sourceDir, const std::string& output,
+                             bool txtReport, bool csvReport, bool comment) :
+                             sourceDirectory(sourceDir), outputFile(output),
+                             outputTxtReport(txtReport), outputCsvReport(csvReport), reDocComment(comment) {
+    while (sourceDirectory.size() > 1 && (sourceDirectory.back() == '/' || sourceDirectory.back() == '\\'))
+        sourceDirectory.pop_back();
+
+    reportFileNoExt = sourceDirectory;
+
+    // Default output file name if output a name is not specified by the user
+    if (outputFile == "")
+        outputFile = sourceDirectory + ".stereotypes.xml";
+
+    parseArchive = srcml_archive_create();
+    srcml_archive_write_open_memory(parseArchive, &parseBuffer, &parseBufferSize);
+    transformArchive = srcml_archive_create();
+}
+
+sourceWatcher::~sourceWatcher() {
+    for (auto& pair : results) srcml_transform_free(pair.second);
+    for (auto& pair : units) srcml_unit_free(pair.second);
+
+    srcml_archive_free(transformArchive);
+    srcml_archive_close(parseArchive);
+    srcml_archive_free(parseArchive);
+    free(parseBuffer);
+}
+
+// Checks if a file is a C++, C#, or Java source file based on its extension
+//
+bool sourceWatcher::isSourceFile(const std::string& path) {
+    const char* language = srcml_archive_check_extension(parseArchive, path.c_str());
+    if (!language) return false;
+
+    std::string unitLanguage = language;
+    return unitLanguage == "C++" || unitLanguage == "C#" || unitLanguage == "Java";
+}
+
+// Collects all source files in a directory (recursively)
+//
+void sourceWatcher::scanDirectory(const std::filesystem::path& directory, std::unordered_set<std::string>& files) {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error))
+        if (entry.is_regular_file(error) && isSourceFile(entry.path().string()))
+            files.insert(entry.path().string());
+}
+
+// Parses a source file into a unit of the parse archive
+// Returns nullptr if the file can't be parsed
+//
+srcml_unit* sourceWatcher::parseFile(const std::string& path) {
+    std::error_code error;
+    srcml_unit* unit = srcml_unit_create(parseArchive);
+    srcml_unit_set_language(unit, srcml_archive_check_extension(parseArchive, path.c_str()));
+    srcml_unit_set_filename(unit, std::filesystem::relative(path, sourceDirectory, error).string().c_str());
+    if (srcml_unit_parse_filename(unit, path.c_str())) {
+        std::cerr << "Error: Unable to parse: " << path << '\n';
+        srcml_unit_free(unit);
+        return nullptr;
+    }
+    return unit;
+}
+
+// Re-parses the changed files (including new and deleted files) and
+//  updates the affected classes, the output archive, and the reports
+//
+void sourceWatcher::refresh(const std::unordered_set<std::string>& changedFiles) {
+    std::unordered_set<int> changedUnits;
+
+    // Sorted so that new files get their unit numbers in a consistent order
+    std::vector<std::string> files(changedFiles.begin(), changedFiles.end());
+    std::sort(files.begin(), files.end());
+
+    for (const std::string& path : files) {
+        std::error_code error;
+        bool exists = std::filesystem::is_regular_file(path, error) && isSourceFile(path);
+
+        auto result = unitNumbers.find(path);
+        if (result == unitNumbers.end() && !exists) continue;
+
+        int unitNumber = 0;
+        if (result == unitNumbers.end()) {
+            unitNumber = nextUnitNumber++;
+            unitNumbers.insert({path, unitNumber});
+        }
+        else
+            unitNumber = result->second;
+        changedUnits.insert(unitNumber);
+
+        // Clean the previous unit of the file
+        if (units.find(unitNumber) != units.end()) {
+            srcml_unit_free(units[unitNumber]);
+            units.erase(unitNumber);
+        }
+        if (results.find(unitNumber) != results.end()) {
+            srcml_transform_free(results[unitNumber]);
+            results.erase(unitNumber);
+        }
+        unitFacts.erase(unitNumber);
+        unitXpaths.erase(unitNumber);
+        unitPaths.erase(unitNumber);
+
+        if (!exists) {
+            unitNumbers.erase(path);
+            continue;
+        }
+
+        srcml_unit* unit = parseFile(path);
+        if (!unit) continue;
+        units.insert({unitNumber, unit});
+        unitPaths.insert({unitNumber, path});
+
+        // Collects class info + methods defined internally to a class
+        classModelCollection& facts = unitFacts[unitNumber];
+        facts.findClassInfo(transformArchive, unit, unitNumber);
+        facts.findFreeFunctions(transformArchive, unit, unitNumber);
+    }
+
+    if (changedUnits.empty()) return;
+
+    std::size_t affected = model.updateUnits(unitFacts, changedUnits);
+
+    outputArchive(changedUnits);
+    model.outputReports(reportFileNoExt, outputTxtReport, outputCsvReport);
+
+    std::cerr << "Updated " << changedUnits.size() << " file(s), " << affected << " class(es) re-analyzed\n";
+}
+
+// Writes the output archive
+// Only units that changed or that have different stereotypes from the last output are transformed again
+// Only one copy of each file is kept: the parsed unit is freed once the file has a stereotyped unit, 
+//  and the file is parsed again if its stereotypes change without the file being edited
+//
+void sourceWatcher::outputArchive(const std::unordered_set<int>& changedUnits) {
+    static const std::unordered_map<std::string, std::string> noXpaths;
+
+    std::mutex mu;
+    for (const auto& pair : unitPaths) {
+        auto xpathList = XPATH_LIST.find(pair.first);
+        const std::unordered_map<std::string, std::string>& xpaths = xpathList != XPATH_LIST.end() ? xpathList->second : noXpaths;
+        auto previous = unitXpaths.find(pair.first);
+        if (changedUnits.find(pair.first) == changedUnits.end() && previous != unitXpaths.end() && previous->second == xpaths)
+            continue;
+
+        if (results.find(pair.first) != results.end()) {
+            srcml_transform_free(results[pair.first]);
+            results.erase(pair.first);
+        }
+
+        auto unit = units.find(pair.first);
+        if (unit == units.end()) {
+            srcml_unit* parsed = parseFile(pair.second);
+            if (!parsed) continue;
+            unit = units.insert({pair.first, parsed}).first;
+        }
+
+        std::map<int, srcml_unit*> transformedUnits;
+        std::unordered_map<int, srcml_transform_result*> unitResults;
+        model.outputWithStereotypes(unit->second, transformedUnits, pair.first, xpaths, unitResults, mu);
+        for (const auto& result : unitResults)
+            results.insert(result);
+
+        if (results.find(pair.first) != results.end()) {
+            srcml_unit_free(unit->second);
+            units.erase(unit);
+        }
+
+        unitXpaths[pair.first] = xpaths;
+    }
+
+    std::string temp = outputFile + ".temp.xml";
+    srcml_archive* archive = srcml_archive_create();
+    if (srcml_archive_write_open_filename(archive, temp.c_str())) {
+        std::cerr << "Error opening: " << temp << '\n';
+        srcml_archive_free(archive);
+        return;
+    }
+    srcml_archive_register_namespace(archive, "st", "http://www.srcML.org/srcML/stereotype");
+
+    for (const auto& pair : unitPaths) {
+        auto result = results.find(pair.first);
+        auto unit = units.find(pair.first);
+        if (result != results.end())
+            srcml_archive_write_unit(archive, srcml_transform_get_unit(result->second, 0));
+        else if (unit != units.end())
+            srcml_archive_write_unit(archive, unit->second);
+    }
+
+    srcml_archive_close(archive);
+    srcml_archive_free(archive);
+
+    std::error_code error;
+    std::filesystem::rename(temp, outputFile, error);
+
+    if (reDocComment)
+        model.outputCommentArchive(outputFile);
+}
+
+// Stereotypes the source directory, then waits for file changes and re-stereotypes the changed files
+// Runs until interrupted (SIGINT or SIGTERM), then removes the temporary output file
+//
+int sourceWatcher::run() {
+#ifdef __linux__
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Unable to initialize inotify\n";
+        return -1;
+    }
+
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE;
+    std::unordered_map<int, std::filesystem::path> watches;
+    auto addWatch = [&](const std::filesystem::path& directory) {
+        int wd = inotify_add_watch(fd, directory.c_str(), mask);
+        if (wd >= 0) watches[wd] = directory;
+
+        std::error_code error;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            if (entry.is_directory(error)) {
+                wd = inotify_add_watch(fd, entry.path().c_str(), mask);
+                if (wd >= 0) watches[wd] = entry.path();
+            }
+        }
+    };
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(sourceDirectory, error)) {
+        std::cerr << "Error: Directory not found: " << sourceDirectory << '\n';
+        close(fd);
+        return -1;
+    }
+    addWatch(sourceDirectory);
+
+    // SIGINT and SIGTERM are blocked except while waiting for events, so they can't 
+    //  arrive between the check of the flag and the wait (or in the middle of an update)
+    sigset_t stopSignals, previousMask, waitMask;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &stopSignals, &previousMask);
+    waitMask = previousMask;
+    sigdelset(&waitMask, SIGINT);
+    sigdelset(&waitMask, SIGTERM);
+
+    struct sigaction action = {};
+    action.sa_handler = stopWatching;
+    sigemptyset(&action.sa_mask);
+    struct sigaction previousInt, previousTerm;
+    sigaction(SIGINT, &action, &previousInt);
+    sigaction(SIGTERM, &action, &previousTerm);
+    STOP_WATCHING = 0;
+
+    std::unordered_set<std::string> changedFiles;
+    scanDirectory(sourceDirectory, changedFiles);
+    refresh(changedFiles);
+    std::cerr << "Watching " << sourceDirectory << " (output: " << outputFile << ")\n";
+
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    const struct timespec pause = {0, 200 * 1000 * 1000};
+    while (!STOP_WATCHING) {
+        changedFiles.clear();
+
+        // Block until the first event, then keep collecting events until
+        //  there is a short pause (editors often write a file in several steps)
+        // Waiting ends early if the watcher is interrupted
+        const struct timespec* timeout = nullptr;
+        pollfd pfd = {fd, POLLIN, 0};
+        while (ppoll(&pfd, 1, timeout, &waitMask) > 0) {
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            if (length <= 0) break;
+
+            for (char* ptr = buffer; ptr < buffer + length; ) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + event->len;
+
+                // Watch is removed (e.g., its directory was deleted)
+                if (event->mask & IN_IGNORED) {
+                    watches.erase(event->wd);
+                    continue;
+                }
+
+                auto watch = watches.find(event->wd);
+                if (watch == watches.end() || event->len == 0) continue;
+                std::filesystem::path path = watch->second / event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addWatch(path);
+                        scanDirectory(path, changedFiles);
+                    }
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                        // All files that were inside the directory are now deleted
+                        std::string directory = path.string() + "/";
+                        for (const auto& pair : unitNumbers)
+                            if (pair.first.compare(0, directory.size(), directory) == 0) changedFiles.insert(pair.first);
+                    }
+                }
+                // New files are picked up once they are written and closed
+                else if (!(event->mask & IN_CREATE))
+                    changedFiles.insert(path.string());
+            }
+            timeout = &pause;
+        }
+
+        if (!STOP_WATCHING) refresh(changedFiles);
+    }
+
+    close(fd);
+    sigaction(SIGINT, &previousInt, nullptr);
+    sigaction(SIGTERM, &previousTerm, nullptr);
+    sigprocmask(SIG_SETMASK, &previousMask, nullptr);
+
+    std::filesystem::remove(outputFile + ".temp.xml", error);
+    std::cerr << "Stopped watching " << sourceDirectory << '\n';
+    return 0;
+#else
+    std::cerr << "Error: Watch mode is only supported on Linux\n";
+    return -1;
+#endif
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file SourceWatcher.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef SOURCEWATCHER_HPP
+#define SOURCEWATCHER_HPP
+
+#include "ClassModelCollection.hpp"
+
+// Watch mode
+// Keeps the class model of a source directory in memory and re-stereotypes
+//  only the files that are edited (Linux only, uses inotify)
+//
+class sourceWatcher {
+public:
+         sourceWatcher                      (const std::string&, const std::string&, bool, bool, bool);
+        ~sourceWatcher                      ();
+
+    int  run                                ();
+
+private:
+    void scanDirectory                      (const std::filesystem::path&, std::unordered_set<std::string>&);
+    bool isSourceFile                       (const std::string&);
+    srcml_unit* parseFile                   (const std::string&);
+    void refresh                            (const std::unordered_set<std::string>&);
+    void outputArchive                      (const std::unordered_set<int>&);
+
+    std::string                                     sourceDirectory;         // Directory being watched
+    std::string                                     outputFile;              // Output srcML archive with stereotypes
+    std::string                                     reportFileNoExt;         // Base name of the report files
+    bool                                            outputTxtReport{false};  // Output optional TXT report file
+    bool                                            outputCsvReport{false};  // Output optional CSV report file
+    bool                                            reDocComment{false};     // Annotate stereotypes as comments
+    srcml_archive*                                  parseArchive{nullptr};   // Archive used to parse source files into units
+    char*                                           parseBuffer{nullptr};    // Memory of the parse archive (nothing is written to it)
+    std::size_t                                     parseBufferSize{0};
+    srcml_archive*                                  transformArchive{nullptr}; // Archive used to apply the xpath transformations
+    classModelCollection                            model;                   // Analyzed classes and free functions of all files
+    std::map<int, classModelCollection>             unitFacts;               // Facts (before any analysis) collected from each unit
+    std::unordered_map<std::string, int>            unitNumbers;             // Key is file path and value is its unit number
+    std::map<int, std::string>                      unitPaths;               // Key is unit number and value is its file path (parsed files only)
+    std::map<int, srcml_unit*>                      units;                   // Parsed unit of each file without stereotypes (or not output yet)
+    std::map<int, srcml_transform_result*>          results;                 // Stereotyped unit of each file (if it has any stereotypes)
+    std::unordered_map
+    <int, std::unordered_map
+    <std::string, std::string>>                     unitXpaths;              // Xpaths and stereotypes used for the last output of each unit
+    int                                             nextUnitNumber{1};       // Count starts at 1 in XPath
+};
+
+#endif
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file Stereotype.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "Stereotype.hpp"
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+
+// Number of stereotypes of a kind
+//
+int stereotypeSet::size(int kind) {
+    if (kind == STEREOTYPE_KIND_FUNCTION) return NUM_FUNCTION_STEREOTYPES;
+    if (kind == STEREOTYPE_KIND_CLASS) return NUM_CLASS_STEREOTYPES;
+    return NUM_METHOD_STEREOTYPES;
+}
+
+// Name of stereotype s of a kind
+//
+const char* stereotypeSet::getName(int kind, int s) {
+    if (kind == STEREOTYPE_KIND_FUNCTION) return FUNCTION_STEREOTYPE_NAMES[s];
+    if (kind == STEREOTYPE_KIND_CLASS) return CLASS_STEREOTYPE_NAMES[s];
+    return METHOD_STEREOTYPE_NAMES[s];
+}
+
+// Adds a stereotype by name (e.g., from the project index)
+// Returns false if the name is not a stereotype of the kind of the set
+//
+bool stereotypeSet::add(std::string_view name) {
+    for (int s = 0; s < size(kind); ++s) {
+        if (name == getName(kind, s)) {
+            add(s);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Names of the stereotypes in the set (in output order)
+//
+std::vector<std::string> stereotypeSet::getNames() const {
+    std::vector<std::string> names;
+    for (int s = 0; s < size(kind); ++s)
+        if (has(s)) names.push_back(getName(kind, s));
+    return names;
+}
+
+// Returns the names of the stereotypes separated by spaces (e.g., "get collaborator")
+// There are only a few distinct combinations of stereotypes, so each one is rendered once
+//  and kept for the rest of the run. Safe to use from multiple threads
+// The strings are never removed, so the returned reference stays valid
+//
+const std::string& stereotypeSet::getString() const {
+    static std::unordered_map<std::uint32_t, std::string>  rendered[NUM_STEREOTYPE_KINDS];
+    static std::shared_mutex                                mu;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mu);
+        auto result = rendered[kind].find(mask);
+        if (result != rendered[kind].end()) return result->second;
+    }
+
+    std::string text;
+    for (int s = 0; s < size(kind); ++s) {
+        if (!has(s)) continue;
+        if (!text.empty()) text += ' ';
+        text += getName(kind, s);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mu);
+    return rendered[kind].emplace(mask, std::move(text)).first->second;
+}
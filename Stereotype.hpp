@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file Stereotype.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef STEREOTYPE_HPP
+#define STEREOTYPE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// Method stereotypes computed by methodFeatures::classifyMethods()
+// Each stereotype is a bit position in the stereotype column. Bits are in the order
+//  the rules are applied, which is also the order stereotypes are listed in the output
+//
+const int                STEREOTYPE_DESTRUCTOR              = 0;
+const int                STEREOTYPE_COPY_CONSTRUCTOR        = 1;
+const int                STEREOTYPE_CONSTRUCTOR             = 2;
+const int                STEREOTYPE_GET                     = 3;
+const int                STEREOTYPE_PREDICATE               = 4;
+const int                STEREOTYPE_PROPERTY                = 5;
+const int                STEREOTYPE_VOID_ACCESSOR           = 6;
+const int                STEREOTYPE_SET                     = 7;
+const int                STEREOTYPE_NON_VOID_COMMAND        = 8;
+const int                STEREOTYPE_COMMAND                 = 9;
+const int                STEREOTYPE_FACTORY                 = 10;
+const int                STEREOTYPE_WRAPPER                 = 11;
+const int                STEREOTYPE_CONTROLLER              = 12;
+const int                STEREOTYPE_COLLABORATOR            = 13;
+const int                STEREOTYPE_INCIDENTAL              = 14;
+const int                STEREOTYPE_STATELESS               = 15;
+const int                STEREOTYPE_EMPTY                   = 16;
+const int                STEREOTYPE_UNCLASSIFIED            = 17;
+const int                NUM_METHOD_STEREOTYPES             = 18;
+
+const char* const        METHOD_STEREOTYPE_NAMES[NUM_METHOD_STEREOTYPES] = {
+    "destructor", "copy-constructor", "constructor", "get", "predicate", "property", "void-accessor", "set",
+    "non-void-command", "command", "factory", "wrapper", "controller", "collaborator", "incidental", "stateless",
+    "empty", "unclassified"
+};
+
+// Free function stereotypes in the order they are listed in the output
+//
+const int                FUNCTION_STEREOTYPE_MAIN           = 0;
+const int                FUNCTION_STEREOTYPE_EMPTY          = 1;
+const int                FUNCTION_STEREOTYPE_PREDICATE      = 2;
+const int                FUNCTION_STEREOTYPE_PROPERTY       = 3;
+const int                FUNCTION_STEREOTYPE_FACTORY        = 4;
+const int                FUNCTION_STEREOTYPE_GLOBAL_COMMAND = 5;
+const int                FUNCTION_STEREOTYPE_COMMAND        = 6;
+const int                FUNCTION_STEREOTYPE_LITERAL        = 7;
+const int                FUNCTION_STEREOTYPE_WRAPPER        = 8;
+const int                FUNCTION_STEREOTYPE_UNCLASSIFIED   = 9;
+const int                NUM_FUNCTION_STEREOTYPES           = 10;
+
+const char* const        FUNCTION_STEREOTYPE_NAMES[NUM_FUNCTION_STEREOTYPES] = {
+    "main", "empty", "predicate", "property", "factory", "global-command", "command", "literal", "wrapper",
+    "unclassified"
+};
+
+// Class stereotypes in the order they are listed in the output
+//
+const int                CLASS_STEREOTYPE_ENTITY            = 0;
+const int                CLASS_STEREOTYPE_MINIMAL_ENTITY    = 1;
+const int                CLASS_STEREOTYPE_DATA_PROVIDER     = 2;
+const int                CLASS_STEREOTYPE_COMMANDER         = 3;
+const int                CLASS_STEREOTYPE_BOUNDARY          = 4;
+const int                CLASS_STEREOTYPE_FACTORY           = 5;
+const int                CLASS_STEREOTYPE_CONTROLLER        = 6;
+const int                CLASS_STEREOTYPE_PURE_CONTROLLER   = 7;
+const int                CLASS_STEREOTYPE_LARGE_CLASS       = 8;
+const int                CLASS_STEREOTYPE_LAZY_CLASS        = 9;
+const int                CLASS_STEREOTYPE_DEGENERATE        = 10;
+const int                CLASS_STEREOTYPE_DATA_CLASS        = 11;
+const int                CLASS_STEREOTYPE_SMALL_CLASS       = 12;
+const int                CLASS_STEREOTYPE_EMPTY             = 13;
+const int                CLASS_STEREOTYPE_UNCLASSIFIED      = 14;
+const int                NUM_CLASS_STEREOTYPES              = 15;
+
+const char* const        CLASS_STEREOTYPE_NAMES[NUM_CLASS_STEREOTYPES] = {
+    "entity", "minimal-entity", "data-provider", "commander", "boundary", "factory", "controller",
+    "pure-controller", "large-class", "lazy-class", "degenerate", "data-class", "small-class", "empty",
+    "unclassified"
+};
+
+// Kind of a stereotype set (selects the stereotype names above)
+//
+const int                STEREOTYPE_KIND_METHOD             = 0;
+const int                STEREOTYPE_KIND_FUNCTION           = 1;
+const int                STEREOTYPE_KIND_CLASS              = 2;
+const int                NUM_STEREOTYPE_KINDS               = 3;
+
+// Stereotypes of a method, a free function, or a class
+// Stored as a bitmask where each bit is one stereotype of the kind of the set
+// The output string (names separated by spaces) is rendered once per distinct bitmask and cached
+//
+class stereotypeSet {
+public:
+                             stereotypeSet           () = default;
+    explicit                 stereotypeSet           (int k, std::uint32_t m = 0) : mask(m), kind(k) {}
+
+    void                     add                     (int s)                 { mask |= 1u << s;                      }
+    bool                     add                     (std::string_view);
+    bool                     has                     (int s)         const   { return (mask >> s) & 1u;              }
+    bool                     hasAny                  (std::uint32_t m) const { return (mask & m) != 0;               }
+    bool                     empty                   ()              const   { return mask == 0;                     }
+    void                     clear                   ()                      { mask = 0;                             }
+    std::uint32_t            getMask                 ()              const   { return mask;                          }
+    int                      getKind                 ()              const   { return kind;                          }
+
+    const std::string&       getString               ()              const;
+    std::vector<std::string> getNames                ()              const;
+
+    static int               size                    (int);
+    static const char*       getName                 (int, int);
+
+private:
+    std::uint32_t            mask{0};                                        // One bit per stereotype
+    int                      kind{STEREOTYPE_KIND_METHOD};                   // Method, free function, or class
+};
+
+#endif
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file SymbolTable.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "SymbolTable.hpp"
+
+// Current local table of each thread (nullptr if names are interned in the global table)
+static thread_local localSymbolTable* CURRENT_LOCAL_SYMBOLS = nullptr;
+
+symbolTable::symbolTable() {
+    intern("");
+}
+
+// Returns the symbol of 's', adding it if it is new
+// Global ids stay below LOCAL_SYMBOL (2^31 strings, far more than fit in memory)
+//
+symbol symbolTable::intern(std::string_view s) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mu);
+        auto result = ids.find(s);
+        if (result != ids.end()) return result->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mu);
+    auto result = ids.find(s);
+    if (result != ids.end()) return result->second;
+
+    std::size_t chunk = count >> CHUNK_BITS;
+    if ((count & (CHUNK_SIZE - 1)) == 0) {
+        if (chunk == directorySize) {
+            // Directory is full. The new one lists the same chunks and is published before the new chunk is added
+            std::size_t size = directorySize ? directorySize * 2 : 16;
+            std::unique_ptr<std::atomic<std::string*>[]> grown(new std::atomic<std::string*>[size]);
+            for (std::size_t i = 0; i < size; ++i)
+                grown[i].store(i < directorySize ? storage[i].get() : nullptr, std::memory_order_relaxed);
+            directory.store(grown.get(), std::memory_order_release);
+            directories.push_back(std::move(grown));
+            directorySize = size;
+        }
+        storage.emplace_back(new std::string[CHUNK_SIZE]);
+        directories.back()[chunk].store(storage.back().get(), std::memory_order_release);
+    }
+
+    std::string& interned = storage[chunk][count & (CHUNK_SIZE - 1)];
+    interned = s;
+    ids.insert({interned, count});
+    return count++;
+}
+
+// Finds the symbol of 's' without adding it
+// Returns false if 's' was never interned (so no map or set keyed on symbols can have it)
+//
+bool symbolTable::find(std::string_view s, symbol& id) const {
+    std::shared_lock<std::shared_mutex> lock(mu);
+    auto result = ids.find(s);
+    if (result == ids.end()) return false;
+    id = result->second;
+    return true;
+}
+
+// Returns the symbol of 's' in the current local table of the thread (or in the global table if there is none)
+//
+symbol symbolTable::internLocal(std::string_view s) {
+    if (CURRENT_LOCAL_SYMBOLS) return CURRENT_LOCAL_SYMBOLS->intern(s);
+    return intern(s);
+}
+
+// Finds the symbol of 's' in the current local table of the thread (or in the global table if there is none)
+//
+bool symbolTable::findLocal(std::string_view s, symbol& id) const {
+    if (CURRENT_LOCAL_SYMBOLS) return CURRENT_LOCAL_SYMBOLS->find(s, id);
+    return find(s, id);
+}
+
+// Removes the strings interned after the first 'size' ones (e.g., the names of the units of a group
+//  once the group is done). Symbols of removed strings must no longer be used by any thread
+//
+void symbolTable::truncate(std::size_t size) {
+    std::unique_lock<std::shared_mutex> lock(mu);
+    if (size == 0 || size >= count) return;   // The empty string is always kept
+
+    for (std::size_t id = size; id < count; ++id) {
+        std::string& interned = storage[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+        ids.erase(interned);
+        std::string().swap(interned);
+    }
+
+    std::size_t usedChunks = (size + CHUNK_SIZE - 1) >> CHUNK_BITS;
+    for (std::size_t i = usedChunks; i < storage.size(); ++i)
+        directories.back()[i].store(nullptr, std::memory_order_relaxed);
+    storage.resize(usedChunks);
+    count = size;
+}
+
+std::size_t symbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mu);
+    return count;
+}
+
+// Local symbols are only valid while their table is the current local table of the thread
+// Returns an empty string if no local table is current or the symbol is not in it (e.g., a local name
+//  read by a report after the method data is analyzed), instead of reading a table that no longer exists
+//
+const std::string& symbolTable::getLocalString(symbol id) {
+    static const std::string empty;
+    if (!CURRENT_LOCAL_SYMBOLS || (id & ~LOCAL_SYMBOL) >= CURRENT_LOCAL_SYMBOLS->size()) return empty;
+    return CURRENT_LOCAL_SYMBOLS->getString(id);
+}
+
+localSymbolTable::localSymbolTable(std::pmr::memory_resource* resource)
+    : strings(resource), ids(resource), previous(CURRENT_LOCAL_SYMBOLS) {
+    CURRENT_LOCAL_SYMBOLS = this;
+}
+
+localSymbolTable::~localSymbolTable() {
+    CURRENT_LOCAL_SYMBOLS = previous;
+}
+
+// Returns the symbol of 's', adding it if it is new
+// Local strings are checked first, so a string keeps the same symbol for the lifetime of the table
+//  even if another thread adds it to the global table later
+//
+symbol localSymbolTable::intern(std::string_view s) {
+    auto result = ids.find(s);
+    if (result != ids.end()) return result->second;
+
+    symbol id = 0;
+    if (SYMBOLS.find(s, id))
+        s = SYMBOLS.getString(id);
+    else {
+        id = symbol(strings.size()) | LOCAL_SYMBOL;
+        strings.emplace_back(s);
+        s = strings.back();
+    }
+    ids.insert({s, id});
+    return id;
+}
+
+// Finds the symbol of 's' (local or global) without adding it
+//
+bool localSymbolTable::find(std::string_view s, symbol& id) const {
+    auto result = ids.find(s);
+    if (result != ids.end()) {
+        id = result->second;
+        return true;
+    }
+    return SYMBOLS.find(s, id);
+}
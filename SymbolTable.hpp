@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file SymbolTable.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef SYMBOLTABLE_HPP
+#define SYMBOLTABLE_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include "FlatHash.hpp"
+
+// Id of an interned string
+//
+using symbol = std::uint32_t;
+
+// Ids with this bit set are local symbols (see localSymbolTable)
+//
+const symbol LOCAL_SYMBOL = symbol(1) << 31;
+
+class localSymbolTable;
+
+// Interns names, types, and signatures so each distinct string is stored once
+//  and maps and sets can be keyed on 32-bit symbols instead of strings
+// Only strings that outlive the analysis of a method are interned here (attribute names and types,
+//  and method signatures). Names of locals, parameters, and calls are local symbols (internLocal())
+// Safe to use from multiple threads. Interned strings are never moved, and are only removed by
+//  truncate() once nothing uses them, so getString() needs no lock and its references stay valid
+// Chunks of strings are listed in a directory that doubles when it is full. Older directories are kept
+//  (a reader may still use one) and every chunk is in all directories made after it
+// Symbol 0 is the empty string
+//
+class symbolTable {
+public:
+                         symbolTable              ();
+                         symbolTable              (const symbolTable&) = delete;
+    symbolTable&         operator=                (const symbolTable&) = delete;
+
+    symbol               intern                   (std::string_view);
+    bool                 find                     (std::string_view, symbol&) const;
+    symbol               internLocal              (std::string_view);
+    bool                 findLocal                (std::string_view, symbol&) const;
+    void                 truncate                 (std::size_t);
+    std::size_t          size                     () const;
+
+    const std::string&   getString                (symbol id) const {
+        if (id & LOCAL_SYMBOL) return getLocalString(id);
+        return directory.load(std::memory_order_acquire)[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+
+private:
+    static const std::string& getLocalString      (symbol);
+
+    static constexpr std::size_t CHUNK_BITS = 12;
+    static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;   // Strings per chunk
+
+    std::unordered_map<std::string_view, symbol>        ids;                     // Key is a view of the interned string
+    std::atomic<std::atomic<std::string*>*>             directory{nullptr};      // Current directory of chunks
+    std::vector<std::unique_ptr<std::atomic<std::string*>[]>> directories;       // Owns the directories (the last one is current)
+    std::size_t                                         directorySize{0};        // Number of chunks the current directory can list
+    std::vector<std::unique_ptr<std::string[]>>         storage;                 // Owns the chunks (never reallocated)
+    symbol                                              count{0};                // Number of interned strings
+    mutable std::shared_mutex                           mu;
+};
+
+// Symbols of names that are only needed while a method is analyzed (locals, parameters, calls,
+//  and variables created with new), so they do not grow the global table
+// Strings are kept in a memory resource (the arena of the analysis) and dropped with the table
+//  (names longer than the small string buffer are freed by the table)
+// A string that is already in the global table keeps its global id, so a local and an attribute
+//  with the same name still have the same symbol
+// While a table exists, it is the current local table of its thread (used by internLocal(),
+//  findLocal(), and getString()). Tables are nested in the order they are created
+//
+class localSymbolTable {
+public:
+    explicit             localSymbolTable         (std::pmr::memory_resource*);
+                         ~localSymbolTable        ();
+                         localSymbolTable         (const localSymbolTable&) = delete;
+    localSymbolTable&    operator=                (const localSymbolTable&) = delete;
+
+    symbol               intern                   (std::string_view);
+    bool                 find                     (std::string_view, symbol&) const;
+    const std::string&   getString                (symbol id) const { return strings[id & ~LOCAL_SYMBOL]; }
+    std::size_t          size                     () const          { return strings.size();              }
+
+private:
+    std::pmr::deque<std::string>                        strings;                 // Local strings (never moved)
+    flatHashMap<std::string_view, symbol, std::hash<std::string_view>, std::equal_to<std::string_view>,
+                std::pmr::polymorphic_allocator<std::pair<std::string_view, symbol>>>  ids;  // Key is a view of a local string
+    localSymbolTable*                                   previous;                // Current table of the thread before this one
+};
+
+// Defined in stereocode.cpp
+extern symbolTable SYMBOLS;
+
+#endif
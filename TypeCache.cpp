@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file TypeCache.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#include "TypeCache.hpp"
+
+// Combines the hashes of the language, the type, and the class name
+//
+std::size_t typeKeyHash::operator()(const typeKeyView& key) const {
+    std::hash<std::string_view> hash;
+    std::size_t h = hash(std::get<0>(key));
+    h ^= hash(std::get<1>(key)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= hash(std::get<2>(key)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+// Returns true and the classification if the type is in the cache
+// currentVersion is the version of the primitives and the type modifiers. Entries of older versions are removed
+//
+bool typeCache::find(const std::string& unitLanguage, const std::string& type, const std::string& className,
+                     std::uint64_t currentVersion, bool& nonPrimitive, bool& nonPrimitiveExternal) {
+    typeKeyView key(unitLanguage, type, className);
+    {
+        std::shared_lock<std::shared_mutex> lock(mu);
+        if (version == currentVersion) {
+            auto result = entries.find(key);
+            if (result == entries.end()) return false;
+            nonPrimitive = result->second.first;
+            nonPrimitiveExternal = result->second.second;
+            return true;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mu);
+    if (version != currentVersion) {
+        entries.clear();
+        version = currentVersion;
+    }
+    return false;
+}
+
+void typeCache::insert(const std::string& unitLanguage, const std::string& type, const std::string& className,
+                       std::uint64_t currentVersion, bool nonPrimitive, bool nonPrimitiveExternal) {
+    std::unique_lock<std::shared_mutex> lock(mu);
+    if (version != currentVersion) {
+        entries.clear();
+        version = currentVersion;
+    }
+    if (entries.size() >= MAX_ENTRIES) entries.clear();
+    if (entries.find(typeKeyView(unitLanguage, type, className)) == entries.end())
+        entries.insert({typeKey(unitLanguage, type, className), {nonPrimitive, nonPrimitiveExternal}});
+}
+
+// Removes all entries and frees their memory (e.g., once a group of units is done in streaming mode)
+//
+void typeCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(mu);
+    entries = decltype(entries)();
+}
+
+std::size_t typeCache::size() {
+    std::shared_lock<std::shared_mutex> lock(mu);
+    return entries.size();
+}
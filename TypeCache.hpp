@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file TypeCache.hpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+#ifndef TYPECACHE_HPP
+#define TYPECACHE_HPP
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <shared_mutex>
+#include <mutex>
+#include <cstdint>
+#include "FlatHash.hpp"
+
+// Key of the cache (language, type, and class name). Entries are looked up with a typeKeyView,
+//  so finding a type does not create any string
+//
+typedef std::tuple<std::string, std::string, std::string>                 typeKey;
+typedef std::tuple<std::string_view, std::string_view, std::string_view>  typeKeyView;
+
+struct typeKeyHash {
+    using is_transparent = void;
+    std::size_t          operator()              (const typeKeyView&) const;
+    std::size_t          operator()              (const typeKey& key) const { 
+        return (*this)(typeKeyView(std::get<0>(key), std::get<1>(key), std::get<2>(key))); 
+    }
+};
+
+// Cache of type classifications (used by isNonPrimitiveType())
+// Key is language, type, and class name. Value is whether the type is non-primitive
+//  and whether it is non-primitive and external (not the class itself)
+// Safe to use from multiple threads
+// The cache is cleared if the primitives or the type modifiers change (checked with their versions)
+// The cache holds at most MAX_ENTRIES entries. It is cleared when it is full, since the key
+//  includes the class name and the number of keys grows with the number of classes
+//
+class typeCache {
+public:
+    bool                 find                    (const std::string&, const std::string&, const std::string&, 
+                                                  std::uint64_t, bool&, bool&);
+    void                 insert                  (const std::string&, const std::string&, const std::string&, 
+                                                  std::uint64_t, bool, bool);
+    void                 clear                   ();
+    std::size_t          size                    ();
+
+    static const std::size_t MAX_ENTRIES = 1 << 16;
+
+private:
+    flatHashMap<typeKey, std::pair<bool, bool>, 
+                typeKeyHash, std::equal_to<>>               entries;            // Classification of each type
+    std::uint64_t                                           version{0};         // Version of primitives and type modifiers the entries are for
+    std::shared_mutex                                       mu;
+};
+
+#endif
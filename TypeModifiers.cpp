@@ -15,10 +15,15 @@ const std::string& typeModifiers::getTypeModifiers (const std::string& unitLang)
     return patterns.at(unitLang);
 }
 
+const typeModifierMatcher& typeModifiers::getMatcher (const std::string& unitLang) const {
+    return matchers.at(unitLang);
+}
+
 // Adds "type" to user-defined type modifiers if not already present
 //
 void typeModifiers::addTypeModifier  (const std::string& type) {
     userMtypes.insert(type);
+    ++version;
 }
 
 // Reads a set of user-defined type Modifiers
@@ -46,9 +51,170 @@ void typeModifiers::outputModifiers() {
     std::cerr << "\n\n";
 }
 
+// Checks if a modifier only contains letters, digits, and '_' (matched as a whole word)
+//
+bool isWordModifier(const std::string& modifier) {
+    for (char c : modifier) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_')
+            return false;
+    }
+    return true;
+}
+
+// Converts a modifier to the text it matches if it has no regular expression syntax other than escaped characters
+//  (e.g., \* or \.\.\.). Returns false otherwise
+//
+bool toLiteralModifier(const std::string& modifier, std::string& literal) {
+    const std::string_view metaCharacters = ".*+?()[]{}|^$";
+    literal.clear();
+    for (std::size_t i = 0; i < modifier.size(); ++i) {
+        char c = modifier[i];
+        if (c == '\\') {
+            if (i + 1 < modifier.size() && !std::isalnum(static_cast<unsigned char>(modifier[i + 1]))) {
+                literal += modifier[++i];
+                continue;
+            }
+            return false;
+        }
+        if (metaCharacters.find(c) != std::string_view::npos) return false;
+        literal += c;
+    }
+    return true;
+}
+
+// Checks if all modifiers can be matched by typeModifierMatcher without a regex
+//
+bool isTrieModifier(const std::unordered_set<std::string>& modifiers) {
+    std::string literal;
+    for (const std::string& s : modifiers) {
+        if (isWordModifier(s) || s == "\\[.*\\]" || s == "@\\w+") continue;
+        if (!toLiteralModifier(s, literal)) return false;
+    }
+    return true;
+}
+
+typeModifierMatcher::typeModifierMatcher() {
+    rootNext.fill(-1);
+    next.emplace_back();
+    terminal.push_back(0);
+}
+
+// Adds a modifier (in the same syntax as the modifiers pattern)
+// Modifiers that are not literal text are ignored, except for \[.*\] and @\w+ 
+//
+void typeModifierMatcher::addModifier(const std::string& modifier, bool isWord) {
+    if (modifier == "\\[.*\\]") {
+        matchBrackets = true;
+        return;
+    }
+    if (modifier == "@\\w+") {
+        matchAnnotations = true;
+        return;
+    }
+
+    std::string literal;
+    if (isWord) literal = modifier;
+    else if (!toLiteralModifier(modifier, literal)) return;
+    if (literal.empty()) return; // Only matches whitespace
+
+    int node = 0;
+    for (char c : literal) {
+        int child = findNext(node, c);
+        if (child < 0) {
+            child = next.size();
+            next.emplace_back();
+            terminal.push_back(0);
+            if (node == 0) rootNext[static_cast<unsigned char>(c)] = child;
+            else next[node].push_back({c, child});
+        }
+        node = child;
+    }
+    // A literal modifier also matches wherever the whole word would match
+    if (terminal[node] != 1) terminal[node] = isWord ? 2 : 1;
+}
+
+void typeModifierMatcher::setFallback(const std::string& pattern) {
+    useFallback = true;
+    fallback = std::regex(pattern);
+}
+
+int typeModifierMatcher::findNext(int node, char c) const {
+    if (node == 0) return rootNext[static_cast<unsigned char>(c)];
+    for (const auto& child : next[node])
+        if (child.first == c) return child.second;
+    return -1;
+}
+
+// Returns the size of the longest modifier that starts at pos (0 if none)
+// previousIsWord is needed since the characters before pos may already be replaced
+//
+std::size_t typeModifierMatcher::matchAt(std::string_view type, std::size_t pos, bool previousIsWord) const {
+    auto isWordChar = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    };
+
+    std::size_t longest = 0;
+    bool wordStart = !previousIsWord && isWordChar(type[pos]);
+    int node = 0;
+    for (std::size_t i = pos; i < type.size(); ++i) {
+        node = findNext(node, type[i]);
+        if (node < 0) break;
+
+        bool wordEnd = i + 1 == type.size() || !isWordChar(type[i + 1]);
+        if (terminal[node] == 1 || (terminal[node] == 2 && wordStart && wordEnd))
+            longest = i - pos + 1;
+    }
+
+    // \[.*\] matches up to the last ']' on the same line
+    if (matchBrackets && type[pos] == '[') {
+        std::size_t lineEnd = type.find_first_of("\n\r", pos + 1);
+        std::size_t closing = type.substr(0, lineEnd).rfind(']');
+        if (closing != std::string_view::npos && closing > pos)
+            longest = std::max(longest, closing - pos + 1);
+    }
+
+    // @\w+
+    if (matchAnnotations && type[pos] == '@') {
+        std::size_t end = pos + 1;
+        while (end < type.size() && isWordChar(type[end])) ++end;
+        if (end > pos + 1) longest = std::max(longest, end - pos);
+    }
+
+    return longest;
+}
+
+// Replaces each modifier with a blank
+// At each position, the longest modifier is replaced
+//
+void typeModifierMatcher::removeModifiers(std::string& type) const {
+    if (useFallback) {
+        type = std::regex_replace(type, fallback, " ");
+        return;
+    }
+
+    // The result is never longer than the type, so it is written in place
+    std::size_t write = 0;
+    std::size_t pos = 0;
+    bool previousIsWord = false;
+    while (pos < type.size()) {
+        std::size_t length = matchAt(type, pos, previousIsWord);
+        char last = type[length ? pos + length - 1 : pos];
+        previousIsWord = (last >= 'a' && last <= 'z') || (last >= 'A' && last <= 'Z') || (last >= '0' && last <= '9') || last == '_';
+
+        if (length) {
+            type[write++] = ' ';
+            pos += length;
+        }
+        else 
+            type[write++] = type[pos++];
+    }
+    type.resize(write);
+}
+
 // Specific type Modifiers are used based on unit language
 //
 void typeModifiers::createModifierList() {
+    ++version;
     for (const auto& l : LANGUAGE) {
         if (l == "C++") {
             mtypes.insert({l, { "const", "volatile", "inline", "virtual", "friend", "extern", "&", "&&", "\\*", "public", "private", "protected",
@@ -118,5 +284,16 @@ void typeModifiers::createModifierList() {
 
         pattern = "(" + pattern + ")";
         patterns.insert({l, pattern});
+
+        typeModifierMatcher matcher;
+        for (const auto& s : mtypes.at(l))
+            matcher.addModifier(s, isWordModifier(s));
+        for (const auto& s : userMtypes)
+            matcher.addModifier(s, isWordModifier(s));
+
+        // Modifiers that can't be matched by the trie
+        if (!isTrieModifier(mtypes.at(l)) || !isTrieModifier(userMtypes)) 
+            matcher.setFallback(pattern);
+        matchers.insert({l, matcher});
     }
 }
@@ -17,20 +17,54 @@
 #include <vector>
 #include <cctype>
 #include <iostream>
+#include <regex>
+#include <array>
+#include <string_view>
+#include <cstdint>
+
+// Removes type modifiers from a type in a single pass (same as replacing the modifiers pattern with " ")
+// Modifiers are stored in a trie. Alphanumeric modifiers only match whole words
+// The \[.*\] (array brackets) and @\w+ (Java annotations) patterns are handled directly
+// If a user-defined modifier uses any other regular expression syntax, the whole pattern is matched with a regex instead
+//
+class typeModifierMatcher {
+public:
+                         typeModifierMatcher   ();
+
+    void                 addModifier           (const std::string&, bool);
+    void                 setFallback           (const std::string&);
+    void                 removeModifiers       (std::string&) const;
+
+private:
+    std::size_t          matchAt               (std::string_view, std::size_t, bool) const;
+    int                  findNext              (int, char) const;
+
+    std::array<int, 256>                            rootNext;                // Child of the root for each character (-1 if none)
+    std::vector<std::vector<std::pair<char, int>>>  next;                    // Children of each node
+    std::vector<char>                               terminal;                // 0 = not a modifier, 1 = modifier, 2 = modifier matched as a whole word
+    bool                                            matchBrackets{false};    // \[.*\] is a modifier
+    bool                                            matchAnnotations{false}; // @\w+ is a modifier
+    bool                                            useFallback{false};      // Use the regex instead of the trie
+    std::regex                                      fallback;                // Regex of all modifiers (only if useFallback)
+};
 
 class typeModifiers {
 public:
     const std::string&   getTypeModifiers   (const std::string&) const;
+    const typeModifierMatcher& getMatcher   (const std::string&) const;
    
     void                 addTypeModifier       (const std::string&);
     void                 createModifierList    ();
     void                 outputModifiers       ();
+    std::uint64_t        getVersion            () const      { return version; }
     friend std::istream& operator>>         (std::istream&, typeModifiers&);
 
 private:
     std::unordered_map<std::string, std::unordered_set<std::string>>       mtypes;          // List of type modifiers
     std::unordered_set<std::string>                                        userMtypes;      // List of user defined type modifiers
-    std::unordered_map<std::string, std::string>                           patterns;                                 
+    std::unordered_map<std::string, std::string>                           patterns;        // Regex pattern of all type modifiers per language
+    std::unordered_map<std::string, typeModifierMatcher>                   matchers;        // Compiled type modifiers per language
+    std::uint64_t                                                          version{0};      // Incremented when the type modifiers change
 };
 
 #endif
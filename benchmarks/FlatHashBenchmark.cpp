@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file FlatHashBenchmark.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+// Compares the node based std::unordered_map and std::unordered_set with flatHashMap and flatHashSet
+//  on the containers of the model, with keys taken from a srcML archive:
+//  variables of each function (symbols, allocated in an arena), method signatures (symbols),
+//  class names (strings looked up with a std::string_view), and the xpaths of each unit
+// Also checks that keys with colliding hashes (a constant hash and a hash with 7 values) don't make
+//  the flat tables grow out of proportion to the number of keys
+// Usage: flat_hash_benchmark [archive (default tests/Cpp.xml)] [iterations]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <unordered_set>
+#include "utils.hpp"
+
+std::vector<std::string>           LANGUAGE = {"C++", "C#", "Java"};
+primitiveTypes                     PRIMITIVES;
+typeModifiers                      TYPE_MODIFIERS;
+symbolTable                        SYMBOLS;
+
+// Names (text of <name> elements with no nested elements) of each function, class, and unit of the archive
+//
+struct archiveKeys {
+    std::vector<std::vector<std::string>>  functions;   // Names used in each function
+    std::vector<std::string>               names;       // All names in the archive (with repeats)
+    std::vector<std::vector<std::string>>  xpaths;      // Xpaths of the functions and classes of each unit
+};
+
+static archiveKeys readArchiveKeys(const std::string& text) {
+    archiveKeys keys;
+    std::vector<std::string>* function = nullptr;
+    int functionCount = 0, classCount = 0;
+    for (std::size_t pos = 0; pos < text.size();) {
+        std::size_t tag = text.find('<', pos);
+        if (tag == std::string::npos) break;
+        std::string_view rest(text.data() + tag, text.size() - tag);
+
+        if (rest.compare(0, 6, "<unit ") == 0) {
+            keys.xpaths.emplace_back();
+            functionCount = classCount = 0;
+        }
+        else if (rest.compare(0, 10, "<function>") == 0 || rest.compare(0, 10, "<function ") == 0) {
+            keys.functions.emplace_back();
+            function = &keys.functions.back();
+            if (keys.xpaths.empty()) keys.xpaths.emplace_back();
+            keys.xpaths.back().push_back("(//src:function)[" + std::to_string(++functionCount) + "]");
+        }
+        else if (rest.compare(0, 7, "<class>") == 0 || rest.compare(0, 7, "<class ") == 0) {
+            if (keys.xpaths.empty()) keys.xpaths.emplace_back();
+            keys.xpaths.back().push_back("(//src:class)[" + std::to_string(++classCount) + "]");
+        }
+        else if (rest.compare(0, 11, "</function>") == 0)
+            function = nullptr;
+        else if (rest.compare(0, 6, "<name>") == 0) {
+            std::size_t start = tag + 6;
+            std::size_t end = text.find('<', start);
+            if (end != std::string::npos && text.compare(end, 7, "</name>") == 0 && end > start) {
+                keys.names.push_back(text.substr(start, end - start));
+                if (function) function->push_back(keys.names.back());
+            }
+        }
+        pos = tag + 1;
+    }
+    return keys;
+}
+
+// Hashes that make every key collide (class names from the source can collide in any hash)
+//
+struct constantHash {
+    std::size_t          operator()             (const std::string&) const { return 42; }
+};
+
+struct mod7Hash {
+    std::size_t          operator()             (const std::string& s) const { return s.size() % 7; }
+};
+
+template <typename F>
+static double timeOf(int iterations, F work) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) work();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void report(const std::string& name, double previous, double current) {
+    std::cout << name << ": unordered " << previous << " us, flat " << current << " us ("
+              << (current > 0 ? previous / current : 0) << "x)\n";
+}
+
+int main (int argc, char const *argv[]) {
+    std::string archive = argc > 1 ? argv[1] : "tests/Cpp.xml";
+    int iterations = 2000;
+    if (argc > 2) {
+        char* end = nullptr;
+        long value = std::strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || value <= 0 || value > std::numeric_limits<int>::max()) {
+            std::cerr << "Usage: flat_hash_benchmark [archive (default tests/Cpp.xml)] [iterations]\n";
+            return -1;
+        }
+        iterations = static_cast<int>(value);
+    }
+
+    std::ifstream in(archive, std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: Unable to open " << archive << '\n';
+        return -1;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    archiveKeys keys = readArchiveKeys(buffer.str());
+
+    std::vector<std::vector<symbol>> functionSymbols;
+    for (const auto& function : keys.functions) {
+        functionSymbols.emplace_back();
+        for (const auto& name : function) functionSymbols.back().push_back(SYMBOLS.intern(name));
+    }
+    std::vector<symbol> symbols;
+    for (const auto& name : keys.names) symbols.push_back(SYMBOLS.intern(name));
+    std::vector<std::string_view> views(keys.names.begin(), keys.names.end());
+
+    std::size_t xpathCount = 0;
+    for (const auto& unit : keys.xpaths) xpathCount += unit.size();
+    std::cout << archive << ": " << keys.names.size() << " names, " << functionSymbols.size() << " functions, "
+              << xpathCount << " xpaths\n";
+
+    std::size_t checksum = 0;
+
+    // Variables of each function, collected in an arena and looked up once for each use
+    std::pmr::monotonic_buffer_resource arena;
+    auto variables = [&](auto tag) {
+        using map = decltype(tag);
+        for (const auto& function : functionSymbols) {
+            {
+                map m(&arena);
+                m.reserve(function.size());
+                for (symbol s : function) {
+                    variable v;
+                    m.insert({s, v});
+                }
+                for (symbol s : function) checksum += m.find(s) != m.end();
+                checksum += m.size();
+            }
+            arena.release();
+        }
+    };
+    double previous = timeOf(iterations, [&] { variables(std::pmr::unordered_map<symbol, variable>()); });
+    double current = timeOf(iterations, [&] { variables(variableMap()); });
+    report("variables per function", previous, current);
+
+    // Method signatures, looked up for each call
+    auto signatures = [&](auto tag) {
+        using set = decltype(tag);
+        set s(symbols.begin(), symbols.end());
+        for (symbol id : symbols) checksum += s.find(id) != s.end();
+        for (symbol id : symbols) checksum += s.find(id + 1) != s.end();
+    };
+    previous = timeOf(iterations, [&] { signatures(std::unordered_set<symbol>()); });
+    current = timeOf(iterations, [&] { signatures(symbolSet()); });
+    report("signatures", previous, current);
+
+    // Class names, looked up with a view of a longer name (e.g., a parent class name without <>)
+    std::unordered_map<std::string, int> previousClasses;
+    flatStringMap<int> currentClasses;
+    for (const auto& name : keys.names) {
+        previousClasses.insert({name, 0});
+        currentClasses.insert({name, 0});
+    }
+    previous = timeOf(iterations, [&] {
+        for (std::string_view v : views) checksum += previousClasses.find(std::string(v)) != previousClasses.end();
+    });
+    current = timeOf(iterations, [&] {
+        for (std::string_view v : views) checksum += currentClasses.find(v) != currentClasses.end();
+    });
+    report("class names", previous, current);
+
+    // Xpaths and stereotypes of each unit, compared with the previous output (watch mode)
+    auto xpaths = [&](auto tag) {
+        using map = decltype(tag);
+        for (const auto& unit : keys.xpaths) {
+            map m;
+            for (const auto& xpath : unit) m.insert({xpath, "get collaborator"});
+            map last = m;
+            checksum += last == m;
+        }
+    };
+    previous = timeOf(iterations, [&] { xpaths(std::unordered_map<std::string, std::string>()); });
+    current = timeOf(iterations, [&] { xpaths(flatStringMap<std::string>()); });
+    report("xpaths per unit", previous, current);
+
+    // Class names with colliding hashes. Lookups are linear in the number of colliding keys in both tables
+    std::vector<std::string> collidingNames;
+    for (int i = 0; i < 2000; ++i) collidingNames.push_back("Class" + std::string(i % 50, 'x') + std::to_string(i));
+    bool bounded = true;
+    auto colliding = [&](auto tag) {
+        using map = decltype(tag);
+        map m;
+        for (const auto& name : collidingNames) m.insert({name, 0});
+        for (const auto& name : collidingNames) checksum += m.find(name) != m.end();
+        if (m.bucket_count() > 4 * collidingNames.size()) bounded = false;
+    };
+    previous = timeOf(1, [&] { colliding(std::unordered_map<std::string, int, constantHash>()); });
+    current = timeOf(1, [&] { colliding(flatHashMap<std::string, int, constantHash>()); });
+    report("class names with a constant hash", previous, current);
+    previous = timeOf(1, [&] { colliding(std::unordered_map<std::string, int, mod7Hash>()); });
+    current = timeOf(1, [&] { colliding(flatHashMap<std::string, int, mod7Hash>()); });
+    report("class names with 7 hashes", previous, current);
+
+    std::cout << "(checksum " << checksum << ")\n";
+    if (!bounded) {
+        std::cerr << "Error: Colliding keys made a table grow to more than 4 buckets per key\n";
+        return -1;
+    }
+    return 0;
+}
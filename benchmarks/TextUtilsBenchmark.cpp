@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file TextUtilsBenchmark.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+// Counts the memory allocations of the text work done for one method
+//  (names of locals, parameters, and attributes, the name signature, and variable lookups)
+//  with the previous std::string utilities and with the string_view utilities
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "utils.hpp"
+
+std::vector<std::string>           LANGUAGE = {"C++", "C#", "Java"};
+primitiveTypes                     PRIMITIVES;
+typeModifiers                      TYPE_MODIFIERS;
+symbolTable                        SYMBOLS;
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept                { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept   { std::free(ptr); }
+
+// Previous versions of the utilities
+//
+void previousRtrim(std::string& s) {
+    std::size_t lastNonSpace = s.find_last_not_of(' ');
+    if (lastNonSpace != std::string::npos)
+        s = s.substr(0, lastNonSpace + 1);   
+}
+
+void previousRemoveNamespace(std::string& name, bool all, const std::string& unitLanguage) {
+    std::size_t last, secondLast;
+    if (unitLanguage == "C++") last = name.rfind("::");
+    else last = name.rfind(".");
+    if (last != std::string::npos) {
+        if (all) {
+            if (unitLanguage == "C++") name = name.substr(last + 2);
+            else name = name.substr(last + 1);
+        }
+        else {
+            if (unitLanguage == "C++") secondLast = name.rfind("::", last - 1);
+            else secondLast = name.rfind(".", last - 1);
+            if (secondLast != std::string::npos) {
+                if (unitLanguage == "C++") name = name.substr(secondLast + 2); 
+                else name = name.substr(secondLast + 1); 
+            }                      
+        }
+    }
+}
+
+const std::vector<std::string> variableNames = {
+    "numberOfRegisteredListeners[MAX_LISTENERS]", "currentConfigurationIndex", "temporaryResultBuffer [ 64 ]",
+    "previouslyVisitedNodes", "accumulatedElapsedTime", "pendingNotificationQueue[]"
+};
+const std::string methodName = "graphics::rendering::SceneRenderer::renderVisibleObjects";
+const std::string parameterList = "(const std::vector<std::pair<int, double>>& objects, Camera* camera, std::map<int, int> lookup)";
+
+// Text work of one method with the previous utilities
+//
+std::size_t previousMethod(std::vector<variable>& variables) {
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < variableNames.size(); ++i) {
+        std::string variableName = variableNames[i].c_str(); // Unparsed text from srcML
+        std::size_t start_position = variableName.find("[");
+        if (start_position != std::string::npos){
+            variableName = variableName.substr(0, start_position);
+            previousRtrim(variableName);
+        }
+        variables[i].setName(SYMBOLS.internLocal(variableName));
+    }
+
+    std::string paramList = parameterList;
+    std::string methName = methodName;
+    removeBetweenComma(paramList, false);
+    previousRemoveNamespace(methName, true, "C++");
+    std::string nameSignature = methName + paramList;
+    trimWhitespace(nameSignature);
+    checksum += nameSignature.size();
+
+    // Each variable is looked up a few times during the analysis
+    for (int lookup = 0; lookup < 4; ++lookup) {
+        for (const variable& v : variables) {
+            std::string name = std::string(v.getName()); // Previously returned by value
+            checksum += name.size();
+        }
+    }
+    return checksum;
+}
+
+// Text work of one method with the string_view utilities
+//
+std::size_t currentMethod(std::vector<variable>& variables) {
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < variableNames.size(); ++i) {
+        std::string_view variableName = variableNames[i].c_str(); // Unparsed text from srcML
+        std::size_t start_position = variableName.find("[");
+        if (start_position != std::string_view::npos)
+            variableName = Rtrim(variableName.substr(0, start_position));
+        variables[i].setName(SYMBOLS.internLocal(variableName));
+    }
+
+    std::string_view methName = removeNamespace(std::string_view(methodName), true, "C++");
+    std::string nameSignature(methName.size() + parameterList.size(), ' ');
+    methName.copy(nameSignature.data(), methName.size());
+    nameSignature.resize(methName.size() + removeBetweenComma(parameterList, false, nameSignature.data() + methName.size()));
+    trimWhitespace(nameSignature);
+    checksum += nameSignature.size();
+
+    for (int lookup = 0; lookup < 4; ++lookup) {
+        for (const variable& v : variables) {
+            const std::string& name = v.getName();
+            checksum += name.size();
+        }
+    }
+    return checksum;
+}
+
+int main (int argc, char const *argv[]) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 100000;
+
+    std::vector<variable> previousVariables(variableNames.size());
+    std::vector<variable> currentVariables(variableNames.size());
+    if (previousMethod(previousVariables) != currentMethod(currentVariables)) {
+        std::cerr << "Error: Different results\n";
+        return -1;
+    }
+    for (std::size_t i = 0; i < variableNames.size(); ++i) {
+        if (previousVariables[i].getName() != currentVariables[i].getName()) {
+            std::cerr << "Error: Different result for " << variableNames[i] << '\n';
+            return -1;
+        }
+    }
+
+    std::size_t checksum = 0;
+    std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) 
+        checksum += previousMethod(previousVariables);
+    auto previousTime = std::chrono::steady_clock::now() - start;
+    std::size_t previousAllocations = allocations - before;
+
+    before = allocations;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) 
+        checksum += currentMethod(currentVariables);
+    auto currentTime = std::chrono::steady_clock::now() - start;
+    std::size_t currentAllocations = allocations - before;
+
+    std::cout << "previous: " << double(previousAllocations) / iterations << " allocations/method, "
+              << std::chrono::duration<double, std::nano>(previousTime).count() / iterations << " ns/method\n";
+    std::cout << "current:  " << double(currentAllocations) / iterations << " allocations/method, "
+              << std::chrono::duration<double, std::nano>(currentTime).count() / iterations << " ns/method\n";
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/**
+ * @file TypeModifiersBenchmark.cpp
+ *
+ * @copyright Copyright (C) 2021-2024 srcML, LLC. (www.srcML.org)
+ *
+ * This file is part of the Stereocode application.
+ */
+
+// Compares removeTypeModifiers() with the previous regex path 
+//  (a std::regex built from the modifiers pattern on every call)
+//
+
+#include <chrono>
+#include "utils.hpp"
+
+std::vector<std::string>           LANGUAGE = {"C++", "C#", "Java"};
+primitiveTypes                     PRIMITIVES;
+typeModifiers                      TYPE_MODIFIERS;
+symbolTable                        SYMBOLS;
+
+int main (int argc, char const *argv[]) {
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 2000;
+
+    TYPE_MODIFIERS.createModifierList();
+
+    const std::vector<std::pair<std::string, std::string>> types = {
+        {"C++",  "const std::vector<int>&"},
+        {"C++",  "static constexpr unsigned long"},
+        {"C++",  "std::unordered_map<std::string, std::vector<Foo*>>::const_iterator"},
+        {"C++",  "virtual const Bar* const"},
+        {"C#",   "public static readonly Dictionary<string, List<int>>"},
+        {"C#",   "ref int[,]"},
+        {"C#",   "Nullable<double>?"},
+        {"Java", "@Override public final Map<String, ArrayList<Integer>>"},
+        {"Java", "String..."},
+        {"Java", "final int[][]"},
+    };
+
+    std::size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto& type : types) {
+            std::regex regexPattern(TYPE_MODIFIERS.getTypeModifiers(type.first));
+            std::string result = std::regex_replace(type.second, regexPattern, " ");
+            checksum += result.size();
+        }
+    }
+    auto regexTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto& type : types) {
+            std::string result = type.second;
+            removeTypeModifiers(result, type.first);
+            checksum += result.size();
+        }
+    }
+    auto matcherTime = std::chrono::steady_clock::now() - start;
+
+    // Results must be the same (ignoring whitespace)
+    for (const auto& type : types) {
+        std::string expected = std::regex_replace(type.second, std::regex(TYPE_MODIFIERS.getTypeModifiers(type.first)), " ");
+        std::string result = type.second;
+        removeTypeModifiers(result, type.first);
+        trimWhitespace(expected);
+        trimWhitespace(result);
+        if (expected != result) {
+            std::cerr << "Error: Different result for " << type.second << ": " << expected << " != " << result << '\n';
+            return -1;
+        }
+    }
+
+    double calls = double(iterations) * types.size();
+    std::cout << "regex:   " << std::chrono::duration<double, std::nano>(regexTime).count() / calls << " ns/call\n";
+    std::cout << "matcher: " << std::chrono::duration<double, std::nano>(matcherTime).count() / calls << " ns/call\n";
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
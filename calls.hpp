@@ -11,22 +11,27 @@
 #define CALLS_HPP
 
 #include <string>
+#include <string_view>
 #include <set>
+#include "SymbolTable.hpp"
 
+// Call in a method. Name and signature are local symbols (SYMBOLS.internLocal())
+//
 class calls {
 public:
-    const std::string&     getName          () const { return name;          } 
-    const std::string&     getArgumentList  () const { return argumentList;  }
-    const std::string&     getSignature     () const { return signature;     }
+    const std::string&     getName          () const { return SYMBOLS.getString(name);      } 
+    const std::string&     getArgumentList  () const { return argumentList;                 }
+    const std::string&     getSignature     () const { return SYMBOLS.getString(signature); }
+    symbol                 getSignatureSymbol () const { return signature;                  }
 
-    void setName            (const std::string& n) { name = n;          }
-    void setArgumentList    (const std::string& l) { argumentList = l;  }
-    void setSignature       (const std::string& s) { signature = s;     }
+    void setName            (symbol n)             { name = n;                       }
+    void setArgumentList    (std::string_view l)   { argumentList = l;               }
+    void setSignature       (symbol s)             { signature = s;                  }
 
 private:
-    std::string       name;
+    symbol            name{0};
     std::string       argumentList;
-    std::string       signature;                   
+    symbol            signature{0};                   
 };
 
 #endif
@@ -8,8 +8,10 @@
  */
 
 #include "ClassModelCollection.hpp"
+#include "SourceWatcher.hpp"
 #include "CLI11.hpp"
 
+symbolTable                        SYMBOLS;                                            // Interned names, types, and signatures (constructed first since other globals may use it)
 primitiveTypes                     PRIMITIVES;                                         // Primitive types per language + any user supplied
 ignorableCalls                     IGNORED_CALLS;                                      // Calls to ignore + any user supplied
 typeModifiers                      TYPE_MODIFIERS;                                     // Modifiers to remove from data types + any user supplied
@@ -25,6 +27,14 @@ std::unordered_map
      <std::string, std::string>>   XPATH_LIST;                         // Map key = unit number. Each map value is a pair of xpath and stereotype
 std::vector<std::string>           LANGUAGE = {"C++", "C#", "Java"};   // Supported languages
 XPathBuilder                       XPATH_TRANSFORMATION;               // List of xpaths used for transformations
+projectIndex                       PROJECT_INDEX;                      // Classes of the rest of the project (from a saved project index)
+summaryPacks                       SUMMARY_PACKS;                      // Classes of external frameworks (from summary packs)
+std::string                        CHECKPOINT_DIRECTORY;               // Directory of checkpoints (no checkpoints if empty)
+int                                CHECKPOINT_INTERVAL         = 1000; // Number of units between checkpoints
+bool                               RESUME                      = false;// Resume from the last checkpoint
+int                                STOP_AFTER_CHECKPOINT       = 0;    // Stop the run after this checkpoint is written (0 = never). Used to test --resume
+bool                               STREAMING                   = false;// Two-phase streaming mode (bounded memory)
+std::size_t                        MAX_MEMORY                  = 0;    // Cap on the estimated size of the methods in memory in bytes (0 = no cap)
 
 int main (int argc, char const *argv[]) {
 
@@ -33,6 +43,14 @@ int main (int argc, char const *argv[]) {
     std::string         ignoredCallsFile;
     std::string         typeModifiersFile;
     std::string         outputFile;
+    std::string         watchDirectory;
+    std::string         indexFile;
+    std::string         saveIndexFile;
+    std::string         exportSummaryFile;
+    std::vector
+    <std::string>       importSummaryFiles;
+    std::vector
+    <std::string>       summaryPackFiles;
     bool                outputTxtReport    = false;
     bool                outputCsvReport    = false;
     bool                overWriteInput     = false;
@@ -41,11 +59,31 @@ int main (int argc, char const *argv[]) {
     CLI::App app{"Stereocode: Determines method and class stereotypes\n"
                  "Supports C++, C#, and Java\n" };
     
-    app.add_option("input-archive",           inputFile,                   "File name of a srcML input archive")->required();
+    CLI::Option* input = 
+    app.add_option("input-archive",           inputFile,                   "File name of a srcML input archive");
+    CLI::Option* watch = 
+    app.add_option("-w,--watch",              watchDirectory,              "Directory of source files to stereotype and re-stereotype on file change (Linux only)");
     app.add_option("-o,--output-file",        outputFile,                  "File name of output - srcML archive with stereotypes");
     app.add_option("-p,--primitive-file",     primitivesFile,              "File name of user supplied primitive types (one per line)");
     app.add_option("-g,--ignore-call-file",   ignoredCallsFile,            "File name of user supplied calls to ignore (one per line)");
     app.add_option("-t,--type-modifier-file", typeModifiersFile,           "File name of user supplied data type modifiers to remove (one per line)");
+    CLI::Option* index = 
+    app.add_option("--index",                 indexFile,                   "File name of a project index used to stereotype part of a project (e.g., a single file)");
+    CLI::Option* saveIndex = 
+    app.add_option("--save-index",            saveIndexFile,               "File name of the project index to write after stereotyping");
+    CLI::Option* exportSummary = 
+    app.add_option("--export-summary",        exportSummaryFile,           "File name of the module summary to write (classes of the input archive used as parents by other archives)");
+    app.add_option("--import-summary",        importSummaryFiles,          "File name(s) of module summaries of other srcML archives (used to find parent classes)");
+    app.add_option("--summary-pack",          summaryPackFiles,            "File name(s) or directories of summary packs of external frameworks (used to find parent classes)");
+    CLI::Option* checkpoint = 
+    app.add_option("--checkpoint",            CHECKPOINT_DIRECTORY,        "Directory of checkpoints written after each phase and every --checkpoint-interval units");
+    app.add_option("--checkpoint-interval",   CHECKPOINT_INTERVAL,         "Number of units between checkpoints (default = 1000)")->check(CLI::PositiveNumber);
+    app.add_flag  ("--resume",                RESUME,                      "Resume from the last checkpoint in the --checkpoint directory")->needs(checkpoint);
+    app.add_option("--stop-after-checkpoint", STOP_AFTER_CHECKPOINT,       "Stop the run after the nth checkpoint is written (used to test --resume)")->needs(checkpoint)->group("");
+    CLI::Option* maxMemory = 
+    app.add_option("--max-memory",            MAX_MEMORY,                  "Cap on the estimated size of the methods kept in memory (e.g., 8GB). Methods over the cap are written to a spill file")->transform(CLI::AsSizeValue(false));
+    CLI::Option* streaming = 
+    app.add_flag  ("--streaming",             STREAMING,                   "Index the classes first, then stereotype and write each unit as soon as its classes are complete (bounded memory)");
     app.add_option("-l,--large-class",        METHODS_PER_CLASS_THRESHOLD, "Method threshold for the large-class stereotype (default = 21)");
     app.add_flag  ("-i,--interface",          INTERFACE,                   "Identify stereotypes for interfaces (C# and Java)");
     app.add_flag  ("-n,--union",              UNION,                       "Identify stereotypes for unions (C++)");
@@ -57,7 +95,28 @@ int main (int argc, char const *argv[]) {
     app.add_flag  ("-c,--comment",            reDocComment,                "Annotates stereotypes as a comment before method and class definitions (/** @stereotype stereotype */)");
     app.add_flag  ("-v,--verbose",            IS_VERBOSE,                  "Outputs default primitives, ignored calls, type modifiers, and extra report files");
     
+    input->excludes(watch);
+    index->excludes(watch);
+    saveIndex->excludes(watch);
+    exportSummary->excludes(watch);
+    checkpoint->excludes(watch);
+    streaming->excludes(watch);
+    streaming->excludes(checkpoint);
+    streaming->excludes(saveIndex);
+    maxMemory->excludes(watch);
+    maxMemory->excludes(checkpoint);
+    maxMemory->excludes(streaming);
+    
     CLI11_PARSE(app, argc, argv);
+
+    if (inputFile == "" && watchDirectory == "") {
+        std::cerr << "Error: input-archive or --watch is required" << '\n';
+        return -1;
+    }
+    if (watchDirectory != "" && overWriteInput) {
+        std::cerr << "Error: --input-overwrite can't be used with --watch" << '\n';
+        return -1;
+    }
     
     // Add user-defined primitive types to initial set
     if (primitivesFile != "") {         
@@ -95,6 +154,74 @@ int main (int argc, char const *argv[]) {
         in.close();
     }
 
+    // Load the classes of the rest of the project
+    if (indexFile != "") {         
+        std::ifstream in(indexFile, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Error: Project index file not found: " << indexFile << '\n';
+            return -1;
+        }
+        if (!(in >> PROJECT_INDEX)) {
+            std::cerr << "Error: Invalid project index file: " << indexFile << '\n';
+            return -1;
+        }
+        in.close();
+    }
+
+    // Load the classes of other modules (a class in the project index takes precedence)
+    for (const std::string& summaryFile : importSummaryFiles) {         
+        std::ifstream in(summaryFile, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Error: Module summary file not found: " << summaryFile << '\n';
+            return -1;
+        }
+        if (!(in >> PROJECT_INDEX)) {
+            std::cerr << "Error: Invalid module summary file: " << summaryFile << '\n';
+            return -1;
+        }
+        in.close();
+    }
+
+    // Load the classes of external frameworks
+    for (const std::string& packFile : summaryPackFiles) {         
+        std::error_code fileError;
+        if (std::filesystem::is_directory(packFile, fileError)) {
+            std::string invalidFile = SUMMARY_PACKS.loadDirectory(packFile);
+            if (invalidFile != "") {
+                std::cerr << "Error: Invalid summary pack file: " << invalidFile << '\n';
+                return -1;
+            }
+            continue;
+        }
+
+        std::ifstream in(packFile, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Error: Summary pack file not found: " << packFile << '\n';
+            return -1;
+        }
+        if (!(in >> SUMMARY_PACKS)) {
+            std::cerr << "Error: Invalid summary pack file: " << packFile << '\n';
+            return -1;
+        }
+        in.close();
+    }
+
+    XPATH_TRANSFORMATION.generateXpath(); // Called here since it depends on globals initalized by user input
+    PRIMITIVES.createPrimitiveList();
+    IGNORED_CALLS.createCallList();
+    TYPE_MODIFIERS.createModifierList();
+
+    if (IS_VERBOSE) {
+        PRIMITIVES.outputPrimitives();
+        IGNORED_CALLS.outputCalls();
+        TYPE_MODIFIERS.outputModifiers();
+    }
+
+    if (watchDirectory != "") {
+        sourceWatcher watcher(watchDirectory, outputFile, outputTxtReport, outputCsvReport, reDocComment);
+        return watcher.run();
+    }
+
     srcml_archive* archive = srcml_archive_create();
     int error = srcml_archive_read_open_filename(archive, inputFile.c_str());   
     if (error) {
@@ -130,9 +257,15 @@ int main (int argc, char const *argv[]) {
     }
     
     // Find stereotypes
-    XPATH_TRANSFORMATION.generateXpath(); // Called here since it depends on globals initalized by user input
-    classModelCollection classObj(archive, outputArchive, 
-                                    inputFile, outputFile, outputTxtReport, outputCsvReport, reDocComment);
+    if (STREAMING) {
+        classModelCollection archiveIndex;
+        archiveIndex.streamStereotypes(archive, outputArchive, 
+                                       inputFile, outputFile, outputTxtReport, outputCsvReport, reDocComment, exportSummaryFile);
+    }
+    else {
+        classModelCollection classObj(archive, outputArchive, 
+                                      inputFile, outputFile, outputTxtReport, outputCsvReport, reDocComment, saveIndexFile, exportSummaryFile);
+    }
 
     if (overWriteInput) {
         std::filesystem::remove(inputFile);
@@ -0,0 +1,41 @@
+# Checks that a run stopped right after a checkpoint gives the same output as a full run once it is resumed
+# Checkpoints are written after every unit. The run is stopped after the first checkpoint, then after the second, 
+#  and so on until there are fewer checkpoints than the stop point and the run completes
+# REFERENCE is the output of a full run (the BASE file by default)
+if (NOT REFERENCE)
+    set(REFERENCE ${TEST_FILE}.BASE.xml)
+endif()
+set(OUTPUT_FILE ${TEST_FILE}.checkpoint.stereotypes.xml)
+set(CHECKPOINT_DIRECTORY ${TEST_FILE}.checkpoint)
+set(CHECKPOINT_OPTIONS --checkpoint ${CHECKPOINT_DIRECTORY} --checkpoint-interval 1)
+
+set(CHECKPOINTS "")
+foreach(STOP RANGE 1 100)
+    # Remove generated files (If they exist already)
+    file(REMOVE_RECURSE ${CHECKPOINT_DIRECTORY})
+    file(REMOVE ${OUTPUT_FILE})
+
+    execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${OUTPUT_FILE} ${CHECKPOINT_OPTIONS} --stop-after-checkpoint ${STOP}
+                    RESULT_VARIABLE RESULT ERROR_VARIABLE ERRORS)
+    if (RESULT EQUAL 0)
+        math(EXPR CHECKPOINTS "${STOP} - 1")
+        break()
+    endif()
+    if (NOT ERRORS MATCHES "Stopped after checkpoint ${STOP}")
+        message(FATAL_ERROR "Run with checkpoints failed:\n${ERRORS}")
+    endif()
+
+    execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${OUTPUT_FILE} ${CHECKPOINT_OPTIONS} --resume
+                    ERROR_VARIABLE ERRORS COMMAND_ERROR_IS_FATAL ANY)
+    if (NOT ERRORS MATCHES "Resuming from checkpoint")
+        message(FATAL_ERROR "Run did not resume from checkpoint ${STOP}:\n${ERRORS}")
+    endif()
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${REFERENCE} ${OUTPUT_FILE} COMMAND_ERROR_IS_FATAL ANY)
+endforeach()
+
+if (CHECKPOINTS STREQUAL "")
+    message(FATAL_ERROR "Run with checkpoints did not complete")
+elseif (CHECKPOINTS EQUAL 0)
+    message(FATAL_ERROR "No checkpoint was written")
+endif()
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${REFERENCE} ${OUTPUT_FILE} COMMAND_ERROR_IS_FATAL ANY)
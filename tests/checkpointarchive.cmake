@@ -0,0 +1,31 @@
+# Runs tests/checkpoint.cmake on an archive with the units of all test archives, so checkpoints are also
+#  written while collecting classes. The reference is a full run of the same archive
+set(TEST_FILE ${TEST_DIR}/checkpoint/Archive)
+file(REMOVE_RECURSE ${TEST_DIR}/checkpoint)
+
+set(UNITS "")
+foreach(NAME Cpp Csharp Java)
+    file(READ ${TEST_DIR}/${NAME}.xml CONTENT)
+    string(REGEX REPLACE "^<\\?xml[^>]*>\n" "" CONTENT "${CONTENT}")
+    string(REPLACE " xmlns=\"http://www.srcML.org/srcML/src\"" "" CONTENT "${CONTENT}")
+    string(APPEND UNITS "\n${CONTENT}\n")
+endforeach()
+file(WRITE ${TEST_FILE}.xml "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\" revision=\"1.0.0\">\n${UNITS}</unit>\n")
+
+set(REFERENCE ${TEST_FILE}.stereotypes.xml)
+execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${REFERENCE} COMMAND_ERROR_IS_FATAL ANY)
+
+include(${CMAKE_CURRENT_LIST_DIR}/checkpoint.cmake)
+
+# A checkpoint is not used once the archive is modified
+file(REMOVE_RECURSE ${CHECKPOINT_DIRECTORY})
+execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${OUTPUT_FILE} ${CHECKPOINT_OPTIONS} --stop-after-checkpoint 1
+                ERROR_QUIET)
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1)
+file(TOUCH ${TEST_FILE}.xml)
+execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${OUTPUT_FILE} ${CHECKPOINT_OPTIONS} --resume
+                ERROR_VARIABLE ERRORS COMMAND_ERROR_IS_FATAL ANY)
+if (NOT ERRORS MATCHES "Checkpoint is not for")
+    message(FATAL_ERROR "Checkpoint of the archive before it was modified was used:\n${ERRORS}")
+endif()
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${REFERENCE} ${OUTPUT_FILE} COMMAND_ERROR_IS_FATAL ANY)
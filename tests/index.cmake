@@ -0,0 +1,24 @@
+# Checks that stereotyping one unit with a project index gives the same stereotypes as a full run:
+#  the full archive is stereotyped with --save-index, then only its second unit is stereotyped with --index
+set(SPLIT_DIR ${TEST_DIR}/index)
+include(${CMAKE_CURRENT_LIST_DIR}/splitarchive.cmake)
+
+# Full run must have the same stereotypes as the BASE file (the same classes in one unit)
+stereotype_archive(CLIENT_EXPECTED --save-index ${SPLIT_DIR}/Archive.index)
+read_stereotypes(${TEST_DIR}/Cpp.BASE.xml EXPECTED)
+read_stereotypes(${SPLIT_DIR}/Archive.stereotypes.xml STEREOTYPES)
+compare_stereotypes("${STEREOTYPES}" "${EXPECTED}" "Full run does not match ${TEST_DIR}/Cpp.BASE.xml")
+
+# Stereotypes of the second unit are the last ones of the BASE file
+list(LENGTH EXPECTED COUNT)
+list(LENGTH CLIENT_EXPECTED CLIENT_COUNT)
+if (CLIENT_COUNT EQUAL 0)
+    message(FATAL_ERROR "Second unit has no stereotypes")
+endif()
+math(EXPR FIRST "${COUNT} - ${CLIENT_COUNT}")
+list(SUBLIST EXPECTED ${FIRST} -1 EXPECTED)
+
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Client.xml -s -i -n -m -o ${SPLIT_DIR}/Client.stereotypes.xml 
+                        --index ${SPLIT_DIR}/Archive.index COMMAND_ERROR_IS_FATAL ANY)
+read_stereotypes(${SPLIT_DIR}/Client.stereotypes.xml STEREOTYPES)
+compare_stereotypes("${STEREOTYPES}" "${EXPECTED}" "Run of one unit with --index does not match ${TEST_DIR}/Cpp.BASE.xml")
@@ -1,8 +1,12 @@
+# OPTIONS holds extra options (e.g., --streaming) and SUFFIX is added to the output file name,
+#  so runs of the same test file with different options don't overwrite each other
+set(OUTPUT_FILE ${TEST_FILE}${SUFFIX}.stereotypes.xml)
+
 # Remove generated XML files (If they exist already)
-execute_process(COMMAND ${CMAKE_COMMAND} -E rm -f ${TEST_FILE}.stereotypes.xml)
+execute_process(COMMAND ${CMAKE_COMMAND} -E rm -f ${OUTPUT_FILE})
 
 # Run stereocode on the test file (struts, interfaces, enums, and unions are considered)
-execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m)
+execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -o ${OUTPUT_FILE} ${OPTIONS})
 
 # Compare the BASE report file to the generated XML file
-execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${TEST_FILE}.BASE.xml ${TEST_FILE}.stereotypes.xml COMMAND_ERROR_IS_FATAL ANY)
\ No newline at end of file
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${TEST_FILE}.BASE.xml ${OUTPUT_FILE} COMMAND_ERROR_IS_FATAL ANY)
\ No newline at end of file
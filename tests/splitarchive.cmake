@@ -0,0 +1,53 @@
+# Splits the C++ test archive into two units before class B (B and A inherit attributes of C in the first unit)
+# Writes Library.xml (first unit), Client.xml (second unit), and Archive.xml (both units) to SPLIT_DIR
+file(REMOVE_RECURSE ${SPLIT_DIR})
+
+file(READ ${TEST_DIR}/Cpp.xml CONTENT)
+string(REGEX REPLACE "^<\\?xml[^>]*>\n" "" CONTENT "${CONTENT}")
+string(REPLACE " xmlns=\"http://www.srcML.org/srcML/src\"" "" CONTENT "${CONTENT}")
+string(STRIP "${CONTENT}" CONTENT)
+
+string(FIND "${CONTENT}" "\n<class>class <name>B</name>" POSITION)
+if (POSITION EQUAL -1)
+    message(FATAL_ERROR "Class B not found in ${TEST_DIR}/Cpp.xml")
+endif()
+string(REGEX MATCH "^<unit [^>]*>" UNIT_TAG "${CONTENT}")
+string(REPLACE "filename=\"C++.cpp\"" "filename=\"Client.cpp\"" CLIENT_TAG "${UNIT_TAG}")
+string(SUBSTRING "${CONTENT}" 0 ${POSITION} LIBRARY_UNIT)
+string(SUBSTRING "${CONTENT}" ${POSITION} -1 CLIENT_UNIT)
+set(LIBRARY_UNIT "${LIBRARY_UNIT}\n</unit>")
+set(CLIENT_UNIT "${CLIENT_TAG}${CLIENT_UNIT}")
+
+set(ARCHIVE_START "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\" revision=\"1.0.0\">\n\n")
+file(WRITE ${SPLIT_DIR}/Library.xml "${ARCHIVE_START}${LIBRARY_UNIT}\n\n</unit>\n")
+file(WRITE ${SPLIT_DIR}/Client.xml "${ARCHIVE_START}${CLIENT_UNIT}\n\n</unit>\n")
+file(WRITE ${SPLIT_DIR}/Archive.xml "${ARCHIVE_START}${LIBRARY_UNIT}\n\n${CLIENT_UNIT}\n\n</unit>\n")
+
+# Stereotypes of an output archive in document order
+# If AFTER is given, only the stereotypes after its first occurrence are read (e.g., the start tag of a unit)
+function(read_stereotypes FILE VAR)
+    file(READ ${FILE} CONTENT)
+    if (ARGC GREATER 2)
+        string(FIND "${CONTENT}" "${ARGV2}" POSITION)
+        if (POSITION EQUAL -1)
+            message(FATAL_ERROR "${ARGV2} not found in ${FILE}")
+        endif()
+        string(SUBSTRING "${CONTENT}" ${POSITION} -1 CONTENT)
+    endif()
+    string(REGEX MATCHALL "st:stereotype=\"[^\"]*\"" STEREOTYPES "${CONTENT}")
+    set(${VAR} "${STEREOTYPES}" PARENT_SCOPE)
+endfunction()
+
+function(compare_stereotypes STEREOTYPES EXPECTED DESCRIPTION)
+    if (NOT "${STEREOTYPES}" STREQUAL "${EXPECTED}")
+        message(FATAL_ERROR "${DESCRIPTION}:\n${STEREOTYPES}\nExpected:\n${EXPECTED}")
+    endif()
+endfunction()
+
+# Stereotypes of the client unit in a full run of both units
+function(stereotype_archive VAR)
+    execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Archive.xml -s -i -n -m -o ${SPLIT_DIR}/Archive.stereotypes.xml ${ARGN}
+                    COMMAND_ERROR_IS_FATAL ANY)
+    read_stereotypes(${SPLIT_DIR}/Archive.stereotypes.xml STEREOTYPES "filename=\"Client.cpp\"")
+    set(${VAR} "${STEREOTYPES}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,35 @@
+# Checks that streaming mode does not keep the names and type classifications of finished groups:
+#  the symbol table must be back to its size after indexing and the type cache must be empty
+set(OUTPUT_FILE ${TEST_FILE}.streaming_memory.stereotypes.xml)
+
+# Remove generated XML files (If they exist already)
+execute_process(COMMAND ${CMAKE_COMMAND} -E rm -f ${OUTPUT_FILE})
+
+# Run stereocode in streaming mode (verbose prints the symbol and type cache counts)
+execute_process(COMMAND ${STEREOCODE} ${TEST_FILE}.xml -s -i -n -m -v --streaming -o ${OUTPUT_FILE}
+                OUTPUT_VARIABLE OUTPUT COMMAND_ERROR_IS_FATAL ANY)
+
+string(REGEX MATCH "Symbols: ([0-9]+) after indexing, ([0-9]+) at most, ([0-9]+) after streaming" SYMBOLS "${OUTPUT}")
+if (NOT SYMBOLS)
+    message(FATAL_ERROR "Symbol counts not found in the output")
+endif()
+set(INDEX_SYMBOLS ${CMAKE_MATCH_1})
+set(PEAK_SYMBOLS ${CMAKE_MATCH_2})
+set(END_SYMBOLS ${CMAKE_MATCH_3})
+if (NOT END_SYMBOLS EQUAL INDEX_SYMBOLS)
+    message(FATAL_ERROR "Symbols of finished groups were kept: ${INDEX_SYMBOLS} after indexing, ${END_SYMBOLS} after streaming")
+endif()
+if (PEAK_SYMBOLS LESS INDEX_SYMBOLS)
+    message(FATAL_ERROR "Invalid symbol counts: ${SYMBOLS}")
+endif()
+
+string(REGEX MATCH "Type cache: ([0-9]+) entries at most per group, ([0-9]+) after streaming" TYPE_CACHE "${OUTPUT}")
+if (NOT TYPE_CACHE)
+    message(FATAL_ERROR "Type cache counts not found in the output")
+endif()
+if (NOT CMAKE_MATCH_2 EQUAL 0)
+    message(FATAL_ERROR "Type cache was not emptied after the last group: ${CMAKE_MATCH_2} entries")
+endif()
+
+# Output must still be the same as the BASE file
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${TEST_FILE}.BASE.xml ${OUTPUT_FILE} COMMAND_ERROR_IS_FATAL ANY)
@@ -0,0 +1,16 @@
+# Checks that a client archive stereotyped with the module summary of its library gets the same stereotypes
+#  as a combined run: the library unit is stereotyped with --export-summary, then the client unit with --import-summary
+set(SPLIT_DIR ${TEST_DIR}/summary)
+include(${CMAKE_CURRENT_LIST_DIR}/splitarchive.cmake)
+
+stereotype_archive(EXPECTED)
+if (NOT EXPECTED MATCHES "data-provider")
+    message(FATAL_ERROR "Client unit has no stereotypes that depend on inherited attributes")
+endif()
+
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Library.xml -s -i -n -m -o ${SPLIT_DIR}/Library.stereotypes.xml 
+                        --export-summary ${SPLIT_DIR}/Library.summary COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Client.xml -s -i -n -m -o ${SPLIT_DIR}/Client.stereotypes.xml 
+                        --import-summary ${SPLIT_DIR}/Library.summary COMMAND_ERROR_IS_FATAL ANY)
+read_stereotypes(${SPLIT_DIR}/Client.stereotypes.xml STEREOTYPES)
+compare_stereotypes("${STEREOTYPES}" "${EXPECTED}" "Client run with --import-summary does not match the combined run")
@@ -0,0 +1,33 @@
+# Checks that summary packs in a directory are grouped by language and loaded in file name order:
+#  the client unit from tests/splitarchive.cmake is stereotyped with a directory of packs that all define class C
+#  - 0-java.summary: Java classes (including C) that must not be used for C++ classes
+#  - 1-library.summary: the library unit, which must be used since it is loaded first
+#  - 2-other.summary: a C++ class C without attributes
+set(SPLIT_DIR ${TEST_DIR}/summarypack)
+set(PACK_DIR ${SPLIT_DIR}/packs)
+include(${CMAKE_CURRENT_LIST_DIR}/splitarchive.cmake)
+file(MAKE_DIRECTORY ${PACK_DIR})
+
+stereotype_archive(EXPECTED)
+
+file(WRITE ${SPLIT_DIR}/Other.xml "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n<unit xmlns=\"http://www.srcML.org/srcML/src\" revision=\"1.0.0\" language=\"C++\" filename=\"Other.cpp\"><class>class <name>C</name> <block>{<private type=\"default\">\n</private>}</block>;</class>\n</unit>\n")
+execute_process(COMMAND ${STEREOCODE} ${TEST_DIR}/Java.xml -s -i -n -m -o ${SPLIT_DIR}/Java.stereotypes.xml 
+                        --export-summary ${PACK_DIR}/0-java.summary COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Library.xml -s -i -n -m -o ${SPLIT_DIR}/Library.stereotypes.xml 
+                        --export-summary ${PACK_DIR}/1-library.summary COMMAND_ERROR_IS_FATAL ANY)
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Other.xml -s -i -n -m -o ${SPLIT_DIR}/Other.stereotypes.xml 
+                        --export-summary ${PACK_DIR}/2-other.summary COMMAND_ERROR_IS_FATAL ANY)
+
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Client.xml -s -i -n -m -o ${SPLIT_DIR}/Client.stereotypes.xml 
+                        --summary-pack ${PACK_DIR} COMMAND_ERROR_IS_FATAL ANY)
+read_stereotypes(${SPLIT_DIR}/Client.stereotypes.xml STEREOTYPES)
+compare_stereotypes("${STEREOTYPES}" "${EXPECTED}" "Client run with --summary-pack does not match the combined run")
+
+# Once the other class C sorts first, it is the one used (so the order of the files is not left to the directory listing)
+file(RENAME ${PACK_DIR}/2-other.summary ${PACK_DIR}/0-other.summary)
+execute_process(COMMAND ${STEREOCODE} ${SPLIT_DIR}/Client.xml -s -i -n -m -o ${SPLIT_DIR}/Client.stereotypes.xml 
+                        --summary-pack ${PACK_DIR} COMMAND_ERROR_IS_FATAL ANY)
+read_stereotypes(${SPLIT_DIR}/Client.stereotypes.xml STEREOTYPES)
+if ("${STEREOTYPES}" STREQUAL "${EXPECTED}")
+    message(FATAL_ERROR "Client run with --summary-pack did not use the first pack in file name order (0-other.summary)")
+endif()
@@ -0,0 +1,78 @@
+# Checks watch mode: the source file of the test is copied into an empty watched directory,
+#  rewritten, and deleted, and the output must follow each change. The watcher is then stopped with SIGTERM
+set(WATCH_DIR ${TEST_FILE}.watch)
+set(OUTPUT_FILE ${TEST_FILE}.watch.stereotypes.xml)
+set(LOG_FILE ${TEST_FILE}.watch.log)
+set(PID_FILE ${TEST_FILE}.watch.pid)
+file(GLOB SOURCE_FILE ${TEST_FILE}.cpp ${TEST_FILE}.cs ${TEST_FILE}.java)
+
+# Remove generated files (If they exist already)
+file(REMOVE_RECURSE ${WATCH_DIR})
+file(REMOVE ${OUTPUT_FILE} ${OUTPUT_FILE}.temp.xml ${LOG_FILE} ${PID_FILE})
+file(MAKE_DIRECTORY ${WATCH_DIR})
+
+# Start the watcher in the background (its output goes to the log file so this call returns right away)
+execute_process(COMMAND sh -c "\"$0\" --watch \"$1\" -s -i -n -m -o \"$2\" < /dev/null > \"$3\" 2>&1 & echo $! > \"$4\""
+                        ${STEREOCODE} ${WATCH_DIR} ${OUTPUT_FILE} ${LOG_FILE} ${PID_FILE} COMMAND_ERROR_IS_FATAL ANY)
+file(READ ${PID_FILE} PID)
+string(STRIP "${PID}" PID)
+
+# Waits until the log file has at least COUNT lines that match PATTERN (30 seconds at most)
+function(wait_for_log PATTERN COUNT)
+    foreach(i RANGE 300)
+        if (EXISTS ${LOG_FILE})
+            file(STRINGS ${LOG_FILE} LINES REGEX "${PATTERN}")
+            list(LENGTH LINES FOUND)
+            if (NOT FOUND LESS COUNT)
+                return()
+            endif()
+        endif()
+        execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 0.1)
+    endforeach()
+    execute_process(COMMAND kill -TERM ${PID})
+    file(READ ${LOG_FILE} LOG)
+    message(FATAL_ERROR "Timed out waiting for \"${PATTERN}\" in the watch log:\n${LOG}")
+endfunction()
+
+# Compares the stereotypes in the output (in order) to the stereotypes in EXPECTED_FILE,
+#  or checks that there are none if EXPECTED_FILE is empty
+# Units are parsed by the watcher, so the rest of the output can differ from the BASE file
+function(check_stereotypes EXPECTED_FILE)
+    set(EXPECTED "")
+    if (EXPECTED_FILE)
+        file(READ ${EXPECTED_FILE} CONTENT)
+        string(REGEX MATCHALL "st:stereotype=\"[^\"]*\"" EXPECTED "${CONTENT}")
+    endif()
+    file(READ ${OUTPUT_FILE} CONTENT)
+    string(REGEX MATCHALL "st:stereotype=\"[^\"]*\"" STEREOTYPES "${CONTENT}")
+    if (NOT "${STEREOTYPES}" STREQUAL "${EXPECTED}")
+        execute_process(COMMAND kill -TERM ${PID})
+        message(FATAL_ERROR "Watch output does not match:\n${STEREOTYPES}\nExpected:\n${EXPECTED}")
+    endif()
+endfunction()
+
+wait_for_log("^Watching" 1)
+
+# New file is stereotyped
+file(COPY ${SOURCE_FILE} DESTINATION ${WATCH_DIR})
+wait_for_log("^Updated 1 file" 1)
+check_stereotypes(${TEST_FILE}.BASE.xml)
+
+# Rewritten file is re-stereotyped
+get_filename_component(SOURCE_NAME ${SOURCE_FILE} NAME)
+file(READ ${SOURCE_FILE} SOURCE)
+file(WRITE ${WATCH_DIR}/${SOURCE_NAME} "${SOURCE}")
+wait_for_log("^Updated 1 file" 2)
+check_stereotypes(${TEST_FILE}.BASE.xml)
+
+# Deleted file is removed from the output
+file(REMOVE ${WATCH_DIR}/${SOURCE_NAME})
+wait_for_log("^Updated 1 file" 3)
+check_stereotypes("")
+
+# SIGTERM ends the watcher, which removes its temporary output file
+execute_process(COMMAND kill -TERM ${PID} COMMAND_ERROR_IS_FATAL ANY)
+wait_for_log("^Stopped watching" 1)
+if (EXISTS ${OUTPUT_FILE}.temp.xml)
+    message(FATAL_ERROR "Temporary output file was not removed: ${OUTPUT_FILE}.temp.xml")
+endif()
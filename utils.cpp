@@ -13,8 +13,43 @@ extern primitiveTypes                        PRIMITIVES;
 extern std::vector<std::string>              LANGUAGE;
 extern typeModifiers                         TYPE_MODIFIERS;  
 
+static typeCache                             TYPE_CACHE;   // Classifications of isNonPrimitiveType()
+
+// Checks if a type is non-primitive. If it is non-primitive and not the class itself, var is set as non-primitive external
+// Results are cached since the same types are checked many times
+//
 bool isNonPrimitiveType(const std::string& type, variable& var, 
                         const std::string& unitLanguage, const std::string& className) {
+    // Primitives and type modifiers only grow, so the sum of their versions changes whenever either changes
+    std::uint64_t version = PRIMITIVES.getVersion() + TYPE_MODIFIERS.getVersion();
+
+    bool isNonPrimitive = false;
+    bool isNonPrimitiveExternal = false;
+    if (!TYPE_CACHE.find(unitLanguage, type, className, version, isNonPrimitive, isNonPrimitiveExternal)) {
+        isNonPrimitive = classifyType(type, unitLanguage, className, isNonPrimitiveExternal);
+        TYPE_CACHE.insert(unitLanguage, type, className, version, isNonPrimitive, isNonPrimitiveExternal);
+    }
+
+    if (isNonPrimitiveExternal) var.setNonPrimitiveExternal(true);
+    return isNonPrimitive;
+}
+
+// Empties the cache of isNonPrimitiveType() (the classifications of the types of a group of units in streaming mode)
+//
+void clearTypeCache() {
+    TYPE_CACHE.clear();
+}
+
+// Returns the number of types in the cache of isNonPrimitiveType()
+//
+std::size_t typeCacheSize() {
+    return TYPE_CACHE.size();
+}
+
+// Classifies a type (see isNonPrimitiveType())
+//
+bool classifyType(const std::string& type, const std::string& unitLanguage, 
+                  const std::string& className, bool& isNonPrimitiveExternal) {
     std::string typeParsed = type;
 
     std::size_t listOpen = typeParsed.find("<");
@@ -42,7 +77,7 @@ bool isNonPrimitiveType(const std::string& type, variable& var,
         if (!isPrimitiveType(subType, unitLanguage)) {
             isNonPrimitive = true;
             if (subType != className)
-                var.setNonPrimitiveExternal(true);
+                isNonPrimitiveExternal = true;
         }
         
         start = end + 1;
@@ -54,35 +89,134 @@ bool isNonPrimitiveType(const std::string& type, variable& var,
     if (!isPrimitiveType(subType, unitLanguage)) {
         isNonPrimitive = true;
         if (subType != className)
-            var.setNonPrimitiveExternal(true);
+            isNonPrimitiveExternal = true;
     }
 
     return isNonPrimitive;
 }
 
 // Checks if a type is primitive.  
+// A comma separated list is primitive only if every type in it is primitive
 //
-bool isPrimitiveType(const std::string& type, const std::string& unitLanguage) {
-    std::istringstream subType(type);
-    std::string token;
-    while (std::getline(subType, token, ','))
-        if (!PRIMITIVES.isPrimitive(token, unitLanguage)) return false;
+bool isPrimitiveType(std::string_view type, std::string_view unitLanguage) {
+    std::size_t start = 0;
+    while (start < type.size()) {
+        std::size_t end = type.find(',', start);
+        if (end == std::string_view::npos) end = type.size();
+        if (!PRIMITIVES.isPrimitive(type.substr(start, end - start), unitLanguage)) return false;
+        start = end + 1;
+    }
     return true;
 }
 
-bool matchSubstring(const std::string& text, const std::string& substring) {
-    const std::string pattern = "\\b" + substring + "\\b"; 
-    const std::regex regexPattern(pattern);
-    std::smatch match;
-    return std::regex_search(text, match, regexPattern);
+// Checks if any of the words appears in the text as a whole word (same as the regex \bword\b)
+// Words must only contain word characters (letters, digits, and '_')
+// Each run of word characters in the text is compared with the words, so the text is scanned once
+//
+bool matchWord(std::string_view text, std::initializer_list<std::string_view> words) {
+    auto isWordChar = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    };
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && !isWordChar(text[pos])) ++pos;
+        std::size_t start = pos;
+        while (pos < text.size() && isWordChar(text[pos])) ++pos;
+        
+        std::string_view token = text.substr(start, pos - start);
+        if (token.empty()) break;
+        for (std::string_view word : words)
+            if (token == word) return true;
+    }
+    return false;
 }
 
+// Matches the start of an expression against the access paths used by methodModel::isVariableUsed()
+//  C++:  (*this).a, this->a, Foo::a, a.b, a->b
+//  Java: super.a, this.a, a.b
+//  C#:   base.a, this.a, base->a, this->a, a.b, a->b
+// owner is the part before the access operator (empty for this, super, and base) and member is the part after it
+// If returnCheck is true, the member must be the end of the expression (e.g., this.a matches but this.a.b doesn't)
+// Same results as the regular expressions previously used in isVariableUsed(), in a single pass and without allocations:
+//  C++:  ^(?:\(\*this\)\.|this->|([^.->]*)(?:::|\.|->))([^.->]*)           return: ...([^.->\(\){}]*)$
+//  Java: ^(?:super|this|([^.]*))\.([^.]*)                              return: ...([^.\(\)]*)$
+//  C#:   ^(?:base|this|([^.->]*))(?:\.|->)([^.->]*)                     return: ...([^.->\(\)]*)$
+// Note that [.->] in these expressions is the character range '.' to '>', which includes '/', digits, ':', ';', '<', and '='
+//  but not '-'. Expressions are expected to have no whitespace
+//
+bool matchAccessPath(std::string_view expr, std::string_view unitLanguage, bool returnCheck, 
+                     std::string_view& owner, std::string_view& member) {
+    owner = std::string_view();
+    member = std::string_view();
+
+    bool isJava = unitLanguage == "Java";
+    bool isCpp = unitLanguage == "C++";
+    if (!isJava && !isCpp && unitLanguage != "C#") return true; // Empty expression always matches
+
+    auto isStop = [](char c) { return c >= '.' && c <= '>'; };
+    auto isMemberChar = [&](char c) {
+        if (isJava) return c != '.' && (!returnCheck || (c != '(' && c != ')'));
+        if (isStop(c)) return false;
+        if (!returnCheck) return true;
+        return c != '(' && c != ')' && (!isCpp || (c != '{' && c != '}'));
+    };
+
+    // Matches the member starting at pos. Without returnCheck, the member is the longest run of member characters,
+    //  otherwise all remaining characters must be member characters
+    auto matchMember = [&](std::size_t pos) {
+        std::size_t end = pos;
+        while (end < expr.size() && isMemberChar(expr[end])) ++end;
+        if (returnCheck && end != expr.size()) return false;
+        member = expr.substr(pos, end - pos);
+        return true;
+    };
+
+    auto startsWith = [&](std::string_view prefix) { return expr.substr(0, prefix.size()) == prefix; };
+
+    if (isCpp) {
+        if (startsWith("(*this).") && matchMember(8)) return true;
+        if (startsWith("this->") && matchMember(6)) return true;
+    }
+    else {
+        std::string_view keyword = isJava ? "super" : "base";
+        for (std::string_view prefix : {keyword, std::string_view("this")}) {
+            if (!startsWith(prefix)) continue;
+            std::size_t pos = prefix.size();
+            if (pos < expr.size() && expr[pos] == '.' && matchMember(pos + 1)) return true;
+            if (!isJava && expr.substr(pos, 2) == "->" && matchMember(pos + 2)) return true;
+        }
+    }
+
+    // Owner is the longest run of characters before the first '.' (Java) or the first character
+    //  in the range '.' to '>' (C++ and C#), then the access operator follows it. 
+    // "->" can only start at the last character of the run since '-' is not in the range
+    std::size_t end = 0;
+    if (isJava) 
+        end = expr.find('.');
+    else 
+        while (end < expr.size() && !isStop(expr[end])) ++end;
+    if (end == std::string_view::npos || end >= expr.size()) return false;
+
+    if (isCpp && expr.substr(end, 2) == "::" && matchMember(end + 2)) {
+        owner = expr.substr(0, end);
+        return true;
+    }
+    if (expr[end] == '.' && matchMember(end + 1)) {
+        owner = expr.substr(0, end);
+        return true;
+    }
+    if (!isJava && end > 0 && expr[end - 1] == '-' && expr[end] == '>' && matchMember(end + 1)) {
+        owner = expr.substr(0, end - 1);
+        return true;
+    }
+    return false;
+}
 
 // Removes specifiers from type name
 //
 void removeTypeModifiers(std::string& type, std::string unitLanguage) {
-    std::regex regexPattern(TYPE_MODIFIERS.getTypeModifiers(unitLanguage));
-    type = std::regex_replace(type, regexPattern, " ");
+    TYPE_MODIFIERS.getMatcher(unitLanguage).removeModifiers(type);
 }
 
 // Removes all whitespace from string
@@ -94,32 +228,38 @@ void trimWhitespace(std::string& s) {
 // Trim blanks of the right of string
 //
 void Rtrim(std::string& s) {
+    s.resize(Rtrim(std::string_view(s)).size());
+}
+
+// Same as Rtrim(), but returns a view of s instead of changing it
+// A string of blanks only is kept as is
+//
+std::string_view Rtrim(std::string_view s) {
     std::size_t lastNonSpace = s.find_last_not_of(' ');
-    if (lastNonSpace != std::string::npos)
-        s = s.substr(0, lastNonSpace + 1);   
+    if (lastNonSpace != std::string_view::npos)
+        s = s.substr(0, lastNonSpace + 1);
+    return s;
 }
 
 // Removes namespaces from names
 // all = false keeps the last :: or .
 //
 void removeNamespace(std::string& name, bool all, std::string_view unitLanguage) {
-    std::size_t last, secondLast;
-    if (unitLanguage == "C++") last = name.rfind("::");
-    else last = name.rfind(".");
-    if (last != std::string::npos) {
-        if (all) {
-            if (unitLanguage == "C++") name = name.substr(last + 2);
-            else name = name.substr(last + 1);
-        }
-        else {
-            if (unitLanguage == "C++") secondLast = name.rfind("::", last - 1);
-            else secondLast = name.rfind(".", last - 1);
-            if (secondLast != std::string::npos) {
-                if (unitLanguage == "C++") name = name.substr(secondLast + 2); 
-                else name = name.substr(secondLast + 1); 
-            }                      
-        }
-    }
+    std::string_view parsed = removeNamespace(std::string_view(name), all, unitLanguage);
+    name.erase(0, parsed.data() - name.data());
+}
+
+// Same as removeNamespace(), but returns a view of name instead of changing it
+//
+std::string_view removeNamespace(std::string_view name, bool all, std::string_view unitLanguage) {
+    std::string_view separator = unitLanguage == "C++" ? "::" : ".";
+    std::size_t last = name.rfind(separator);
+    if (last == std::string_view::npos) return name;
+    if (all) return name.substr(last + separator.size());
+
+    std::size_t secondLast = name.rfind(separator, last - 1);
+    if (secondLast != std::string_view::npos) return name.substr(secondLast + separator.size());
+    return name;
 }
 
 // Converts all whitespaces to blanks  ('\r' => ' ')
@@ -135,32 +275,70 @@ void WStoBlank(std::string& s) {
 //  and Foo(int, std::pair<int, int>, double) becomes Foo(,,)
 //
 void removeBetweenComma(std::string& s, bool isGeneric) {
-    std::size_t opening;
-    if (isGeneric)
-      opening = s.find("<");
-    else
-      opening = s.find("(");
-
-    if (opening != std::string::npos) {
-        std::string name = s.substr(0, opening + 1);
-        s = s.substr(opening + 1);
-        
-        // This could be nested inside () or <> for types
-        // <[^>]*> --> starts at <, then matches everything except > and stops at > including the >
-        std::string pattern = R"(<[^>]*>)";  
-        std::regex regexPattern(pattern);
-        s = std::regex_replace(s, regexPattern, "");  
-        
-        pattern = "";
-        if (isGeneric)
-          pattern = R"(([^,]*)(,|>))";
-        else
-          pattern = R"(([^,]*)(,|\)))";
-        
-        const std::regex regexPatternTwo (pattern);
-        s = std::regex_replace(s, regexPatternTwo, "$2"); // $2 is used to replace the content with the second group
-        s = name + s;
+    s.resize(removeBetweenComma(s, isGeneric, s.data()));
+}
+
+// Writes the result of removeBetweenComma() to buffer and returns its size
+// buffer must have room for s.size() characters. It can be s itself since the result is never longer than s
+// Only commas at the top level of the list are kept, so nested (), [], {}, and generic <> are skipped
+// In (), < and > are only treated as brackets if they are balanced (e.g., not in foo(a < b, c))
+// Characters after the end of the list are kept as is
+//
+std::size_t removeBetweenComma(std::string_view s, bool isGeneric, char* buffer) {
+    char opening = isGeneric ? '<' : '(';
+    char closing = isGeneric ? '>' : ')';
+
+    std::size_t listOpen = s.find(opening);
+    if (listOpen == std::string_view::npos) {
+        if (buffer != s.data()) s.copy(buffer, s.size());
+        return s.size();
     }
+
+    // Checks if < and > are balanced inside ()
+    bool useAngles = isGeneric;
+    if (!isGeneric) {
+        int depth = 0;
+        int angleDepth = 0;
+        for (std::size_t i = listOpen + 1; i < s.size(); ++i) {
+            char c = s[i];
+            if (c == '(' || c == '[' || c == '{') ++depth;
+            else if (c == ')' || c == ']' || c == '}') {
+                if (depth == 0 && c == ')') break;
+                if (depth > 0) --depth;
+            }
+            else if (c == '<') ++angleDepth;
+            else if (c == '>' && s[i - 1] != '-' && angleDepth > 0) --angleDepth; 
+        }
+        useAngles = angleDepth == 0;
+    }
+
+    std::size_t size = listOpen + 1;
+    if (buffer != s.data()) s.copy(buffer, size);
+
+    int depth = 0;
+    char previous = opening;
+    std::size_t i = listOpen + 1;
+    for (; i < s.size(); ++i) {
+        char c = s[i];
+        bool isOpening = c == '(' || c == '[' || c == '{' || (useAngles && c == '<');
+        bool isClosing = c == ')' || c == ']' || c == '}' || (useAngles && c == '>' && previous != '-');
+        previous = c;
+
+        if (isOpening) ++depth;
+        else if (isClosing) {
+            if (depth == 0 && c == closing) {
+                buffer[size++] = c;
+                ++i;
+                break;
+            }
+            if (depth > 0) --depth;
+        }
+        else if (c == ',' && depth == 0) buffer[size++] = c;
+    }
+
+    // Rest of the string after the list
+    for (; i < s.size(); ++i) buffer[size++] = s[i];
+    return size;
 }
 
 // Workaround to get Stereocode to work with srcML 1.0.0
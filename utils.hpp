@@ -19,22 +19,32 @@
 #include <unordered_map>
 #include <map>
 #include <cstddef>
+#include <initializer_list>
 #include "PrimitiveTypes.hpp"
 #include "TypeModifiers.hpp"
 #include "variable.hpp"
+#include "TypeCache.hpp"
  
 
 bool                            isNonPrimitiveType            (const std::string& type, variable&, 
                                                                const std::string& unitLanguage, const std::string& className);
-bool                            isPrimitiveType               (const std::string&, const std::string& unitLanguage);
-bool                            matchSubstring                (const std::string&, const std::string&);
+bool                            classifyType                  (const std::string&, const std::string&, const std::string&, bool&);
+void                            clearTypeCache                ();
+std::size_t                     typeCacheSize                 ();
+bool                            isPrimitiveType               (std::string_view, std::string_view unitLanguage);
+bool                            matchWord                     (std::string_view, std::initializer_list<std::string_view>);
+bool                            matchAccessPath               (std::string_view, std::string_view, bool, 
+                                                               std::string_view&, std::string_view&);
 void                            createSpecifierList           ();
 void                            removeTypeModifiers           (std::string&, std::string);
 void                            trimWhitespace                (std::string&);
 void                            Ltrim                         (std::string&);
 void                            Rtrim                         (std::string&);
+std::string_view                Rtrim                         (std::string_view);
 void                            removeNamespace               (std::string&, bool, std::string_view);
+std::string_view                removeNamespace               (std::string_view, bool, std::string_view);
 void                            WStoBlank                     (std::string&);
 void                            removeBetweenComma            (std::string& s, bool);
+std::size_t                     removeBetweenComma            (std::string_view, bool, char*);
 void                            srcmlBackwardCompatibility    (std::string&);
 #endif
@@ -11,29 +11,56 @@
 #define VARIABLE_HPP
 
 #include "utils.hpp"
+#include "SymbolTable.hpp"
+#include "FlatHash.hpp"
+#include <memory_resource>
+#include <memory>
 
 // Used to store data members (attributes or fields), locals, and parameters
+// Names and types of attributes are global symbols (SYMBOLS.intern()), and names and types
+//  of locals and parameters are local symbols (SYMBOLS.internLocal())
 //
 class variable {
 public:
-    void        setName                 (const std::string& t)         { name = t;                   }
-    void        setType                 (const std::string& t)         { type = t;                   }
+    void        setName                 (symbol t)                     { name = t;                   }
+    void        setType                 (symbol t)                     { type = t;                   }
     void        setNonPrimitiveExternal (const bool m)                 { nonPrimitiveExternal = m;   }
     void        setNonPrimitive         (const bool m)                 { nonPrimitive = m;           }
     void        setPos                  (const int p)                  { pos = p;                    }
+    void        setInherited            (const bool m)                 { inherited = m;              }
 
-    std::string getName                 () const                       { return name;                }
-    std::string getType                 () const                       { return type;                }
+    const std::string& getName          () const                       { return SYMBOLS.getString(name); }
+    const std::string& getType          () const                       { return SYMBOLS.getString(type); }
+    symbol      getNameSymbol           () const                       { return name;                }
+    symbol      getTypeSymbol           () const                       { return type;                }
     bool        getNonPrimitiveExternal () const                       { return nonPrimitiveExternal;} 
     bool        getNonPrimitive         () const                       { return nonPrimitive;        }
     int         getPos                  () const                       { return pos;                 }
+    bool        getInherited            () const                       { return inherited;           }
     
 private:
-    std::string name;                         // Variable name
-    std::string type;                         // Variable type
+    symbol      name{0};                      // Variable name
+    symbol      type{0};                      // Variable type
     bool        nonPrimitiveExternal{false};  // True if variable is non-primitive and not of same type as class it belongs to
     bool        nonPrimitive{false};          // True if variable is non-primitive
-    int         pos{-1};                      // Position of variable (Starting at 0)         
+    int         pos{-1};                      // Position of variable (Starting at 0)
+    bool        inherited{false};             // True if variable is an attribute inherited from a parent class         
 };
 
+// Variables keyed by name
+// Uses a memory resource, so the variables of a method can be allocated in an arena during analysis
+//
+using variableMap = flatHashMap<symbol, variable, std::hash<symbol>, std::equal_to<symbol>,
+                                std::pmr::polymorphic_allocator<std::pair<symbol, variable>>>;
+
+// Set of names or signatures
+// Uses a memory resource for the same reason as variableMap (the default resource unless one is given)
+//
+using symbolSet = flatHashSet<symbol, std::hash<symbol>, std::equal_to<symbol>, std::pmr::polymorphic_allocator<symbol>>;
+
+// Non-private attributes of a class as seen by its child classes
+// A layer is never modified once it is shared, so every child class references the same layer instead of copying it
+//
+using attributeLayer = std::shared_ptr<const variableMap>;
+
 #endif